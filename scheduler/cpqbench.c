@@ -0,0 +1,215 @@
+/** @file cpqbench.c
+ *
+ * Measures how the concurrent priqueue (libcpriqueue) scales with the number of
+ * threads, against the simplest alternative: one priqueue_t behind one mutex.
+ *
+ * The queue is filled with <elements> elements, then every thread repeatedly polls
+ * an element and offers it back with a new random key, so the size stays constant.
+ * The operations are split evenly over 1, 2, 4, ... up to <max threads> threads.
+ * Afterwards the queue is drained on one thread, checking that every element comes
+ * out exactly once, and counting how often a key is smaller than the one polled
+ * before it (always 0 for the locked priqueue, the price of relaxation otherwise).
+ *
+ * Usage: ./cpqbench [max threads] [elements] [operations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "libpriqueue/libpriqueue.h"
+#include "libcpriqueue/libcpriqueue.h"
+
+#define KEY_RANGE 1000000
+
+typedef struct _bench_t
+{
+	int concurrent;
+	cpriqueue_t cqueue;
+	priqueue_t queue;
+	pthread_mutex_t lock;
+} bench_t;
+
+typedef struct _worker_t
+{
+	bench_t *bench;
+	long operations;
+	unsigned int seed;
+	pthread_t thread;
+} worker_t;
+
+static double now()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void bench_offer(bench_t *bench, void *ptr, long long key)
+{
+	if (bench->concurrent)
+	{
+		cpriqueue_offer(&bench->cqueue, ptr, key);
+		return;
+	}
+
+	pthread_mutex_lock(&bench->lock);
+	priqueue_offer_keyed(&bench->queue, ptr, key);
+	pthread_mutex_unlock(&bench->lock);
+}
+
+static void *bench_poll(bench_t *bench, long long *key)
+{
+	void *ptr;
+
+	if (bench->concurrent)
+	{
+		ptr = cpriqueue_poll(&bench->cqueue);
+		if (ptr != NULL)
+			*key = *(int *)ptr;
+		return ptr;
+	}
+
+	pthread_mutex_lock(&bench->lock);
+	ptr = priqueue_poll(&bench->queue);
+	pthread_mutex_unlock(&bench->lock);
+	if (ptr != NULL)
+		*key = *(int *)ptr;
+	return ptr;
+}
+
+/*
+ * Each element is an int holding its current key, so the drain can check order.
+ */
+static void *worker_run(void *arg)
+{
+	worker_t *worker = arg;
+	long i;
+	long long key;
+
+	for (i = 0; i < worker->operations; i++)
+	{
+		int *element = bench_poll(worker->bench, &key);
+		if (element == NULL)
+			continue;
+
+		*element = rand_r(&worker->seed) % KEY_RANGE;
+		bench_offer(worker->bench, element, *element);
+	}
+
+	return NULL;
+}
+
+/*
+ * Runs one configuration.
+ * @return the elapsed time, or a negative value if the drain found an element
+ *         missing or duplicated
+ */
+static double run(bench_t *bench, int threads, int *elements, int count, long operations, long *out_of_order)
+{
+	worker_t *workers = malloc(threads * sizeof(worker_t));
+	char *seen = calloc(count, 1);
+	long long key, last = -1;
+	int i, drained = 0;
+	int *element;
+
+	if (bench->concurrent)
+		cpriqueue_init(&bench->cqueue, 4 * threads);
+	else
+	{
+		priqueue_init_keyed(&bench->queue);
+		pthread_mutex_init(&bench->lock, NULL);
+	}
+
+	srand(678);
+	for (i = 0; i < count; i++)
+	{
+		elements[i] = rand() % KEY_RANGE;
+		bench_offer(bench, &elements[i], elements[i]);
+	}
+
+	double start = now();
+	for (i = 0; i < threads; i++)
+	{
+		workers[i].bench = bench;
+		workers[i].operations = operations / threads;
+		workers[i].seed = 678 + i;
+		pthread_create(&workers[i].thread, NULL, worker_run, &workers[i]);
+	}
+	for (i = 0; i < threads; i++)
+		pthread_join(workers[i].thread, NULL);
+	double elapsed = now() - start;
+
+	*out_of_order = 0;
+	while ((element = bench_poll(bench, &key)) != NULL)
+	{
+		int index = element - elements;
+		if (seen[index])
+			break;
+		seen[index] = 1;
+		drained++;
+
+		if (key < last)
+			(*out_of_order)++;
+		last = key;
+	}
+
+	if (bench->concurrent)
+		cpriqueue_destroy(&bench->cqueue);
+	else
+	{
+		priqueue_destroy(&bench->queue);
+		pthread_mutex_destroy(&bench->lock);
+	}
+	free(workers);
+	free(seen);
+
+	return drained == count ? elapsed : -1;
+}
+
+int main(int argc, char **argv)
+{
+	int max_threads = argc > 1 ? atoi(argv[1]) : 64;
+	int count = argc > 2 ? atoi(argv[2]) : 1024;
+	long operations = argc > 3 ? atol(argv[3]) : 1000000;
+	int threads;
+
+	if (max_threads <= 0 || count <= 0 || operations <= 0)
+	{
+		fprintf(stderr, "Usage: %s [max threads] [elements] [operations]\n", argv[0]);
+		return 1;
+	}
+
+	int *elements = malloc(count * sizeof(int));
+	bench_t bench;
+
+	printf("%d elements, %ld poll+offer pairs per run\n", count, operations);
+	printf("%8s  %26s  %26s  %8s\n", "Threads", "Locked priqueue", "Multi-queue (4/thread)", "Speedup");
+
+	for (threads = 1; threads <= max_threads; threads *= 2)
+	{
+		long locked_disorder, multi_disorder;
+
+		bench.concurrent = 0;
+		double locked = run(&bench, threads, elements, count, operations, &locked_disorder);
+		bench.concurrent = 1;
+		double multi = run(&bench, threads, elements, count, operations, &multi_disorder);
+
+		if (locked < 0 || multi < 0)
+		{
+			fprintf(stderr, "Elements were lost or duplicated with %d thread(s).\n", threads);
+			return 2;
+		}
+
+		printf("%8d  %9.2f Mops/s %6.1f%% ooo  %9.2f Mops/s %6.1f%% ooo  %7.2fx\n", threads,
+				operations / locked / 1e6, 100.0 * locked_disorder / count,
+				operations / multi / 1e6, 100.0 * multi_disorder / count,
+				locked / multi);
+	}
+
+	printf("(ooo: share of the final drain that came out of key order)\n");
+
+	free(elements);
+	return 0;
+}
@@ -0,0 +1,99 @@
+/** @file eventdiff.c
+ *
+ * Compares two event logs written by the simulator's -e option, in either format,
+ * and reports the first event where they differ, after the last few events they
+ * agree on. Unlike comparing the averages, this catches any change in scheduling
+ * decisions.
+ *
+ * Usage: ./eventdiff <log a> <log b>
+ * Exits with 0 if the logs are identical, 1 if they differ and 2 on error.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libeventlog/libeventlog.h"
+
+#define CONTEXT 3
+
+static eventlog_t log_a, log_b;
+
+static int same_event(const event_t *a, const event_t *b)
+{
+	return a->time == b->time && a->type == b->type && a->core == b->core && a->job == b->job;
+}
+
+static void print_side(const char *name, int got, const event_t *event)
+{
+	printf("  %s: ", name);
+	if (got == 1)
+		eventlog_print(event, stdout);
+	else
+		printf("(end of log)");
+	printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+	event_t a, b, context[CONTEXT];
+	long events = 0;
+	int got_a, got_b;
+	long i;
+
+	if (argc != 3)
+	{
+		fprintf(stderr, "Usage: %s <log a> <log b>\n", argv[0]);
+		return 2;
+	}
+
+	if (!eventlog_open(&log_a, argv[1], 0) || !eventlog_open(&log_b, argv[2], 0))
+	{
+		fprintf(stderr, "Unable to open \"%s\" as an event log.\n", log_a.mfile == NULL ? argv[1] : argv[2]);
+		return 2;
+	}
+
+	while (1)
+	{
+		got_a = eventlog_read(&log_a, &a);
+		got_b = eventlog_read(&log_b, &b);
+
+		if (got_a == -1 || got_b == -1)
+		{
+			fprintf(stderr, "\"%s\" is malformed after %ld event(s).\n", got_a == -1 ? argv[1] : argv[2], events);
+			return 2;
+		}
+
+		if (got_a == 0 && got_b == 0)
+		{
+			printf("%ld event(s), identical.\n", events);
+			return 0;
+		}
+
+		if (got_a != got_b || !same_event(&a, &b))
+			break;
+
+		context[events % CONTEXT] = a;
+		events++;
+	}
+
+	printf("Logs differ at event %ld", events + 1);
+	if (got_a == 1 || got_b == 1)
+		printf(" (time %d)", got_a == 1 ? a.time : b.time);
+	printf(":\n");
+
+	for (i = (events > CONTEXT ? events - CONTEXT : 0); i < events; i++)
+	{
+		printf("  =: ");
+		eventlog_print(&context[i % CONTEXT], stdout);
+		printf("\n");
+	}
+
+	print_side("a", got_a, &a);
+	print_side("b", got_b, &b);
+
+	eventlog_close(&log_a);
+	eventlog_close(&log_b);
+
+	return 1;
+}
@@ -0,0 +1,158 @@
+/** @file jobtablebench.c
+ *
+ * Compares the simulator's per time unit passes over the job table when the jobs
+ * are stored as an array of structs (the old simulator_job_list_t) and as a struct
+ * of arrays (simulator_job_table_t): finish detection, arrival detection and
+ * running the time unit.
+ *
+ * Usage: ./jobtablebench [jobs] [time units]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef struct _aos_job_t
+{
+	int job_id, arrival_time, run_time, priority;
+	int core_id, arrived;
+} aos_job_t;
+
+static double now()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static long run_aos(aos_job_t *jobs, int count, int units)
+{
+	long checksum = 0;
+	int time, i;
+
+	for (time = 0; time < units; time++)
+	{
+		int finished = 0, arrived = 0, cores_working = 0;
+
+		for (i = 0; i < count; i++)
+			if (jobs[i].run_time == 0)
+				finished++;
+
+		for (i = 0; i < count; i++)
+			if (jobs[i].arrival_time == time)
+				arrived++;
+
+		for (i = 0; i < count; i++)
+		{
+			if (jobs[i].core_id != -1)
+			{
+				cores_working++;
+				jobs[i].run_time--;
+			}
+		}
+
+		checksum += finished + arrived + cores_working;
+	}
+
+	return checksum;
+}
+
+static int count_equal(const int * restrict column, int count, int value)
+{
+	int i, matches = 0;
+
+	for (i = 0; i < count; i++)
+		matches += (column[i] == value);
+
+	return matches;
+}
+
+static int run_unit(int * restrict run_time, const int * restrict core_id, int count)
+{
+	int i, cores_working = 0;
+
+	for (i = 0; i < count; i++)
+	{
+		int running = (core_id[i] != -1);
+		run_time[i] -= running;
+		cores_working += running;
+	}
+
+	return cores_working;
+}
+
+static long run_soa(int *arrival_time, int *run_time, int *core_id, int count, int units)
+{
+	long checksum = 0;
+	int time;
+
+	for (time = 0; time < units; time++)
+	{
+		int finished = count_equal(run_time, count, 0);
+		int arrived = count_equal(arrival_time, count, time);
+		int cores_working = run_unit(run_time, core_id, count);
+
+		checksum += finished + arrived + cores_working;
+	}
+
+	return checksum;
+}
+
+int main(int argc, char **argv)
+{
+	int count = argc > 1 ? atoi(argv[1]) : 1000000;
+	int units = argc > 2 ? atoi(argv[2]) : 200;
+	int i;
+
+	if (count <= 0 || units <= 0)
+	{
+		fprintf(stderr, "Usage: %s [jobs] [time units]\n", argv[0]);
+		return 1;
+	}
+
+	aos_job_t *jobs = malloc(count * sizeof(aos_job_t));
+	int *arrival_time = malloc(count * sizeof(int));
+	int *run_time = malloc(count * sizeof(int));
+	int *priority = malloc(count * sizeof(int));
+	int *core_id = malloc(count * sizeof(int));
+
+	/* Roughly one job in ten is on a core; nobody finishes during the run. */
+	srand(678);
+	for (i = 0; i < count; i++)
+	{
+		jobs[i].job_id = i;
+		jobs[i].arrival_time = arrival_time[i] = rand() % count;
+		jobs[i].run_time = run_time[i] = units + 1 + rand() % 100;
+		jobs[i].priority = priority[i] = rand() % 10;
+		jobs[i].core_id = core_id[i] = (rand() % 10 == 0) ? rand() % 64 : -1;
+		jobs[i].arrived = 0;
+	}
+
+	double start = now();
+	long aos_checksum = run_aos(jobs, count, units);
+	double aos_time = now() - start;
+
+	start = now();
+	long soa_checksum = run_soa(arrival_time, run_time, core_id, count, units);
+	double soa_time = now() - start;
+
+	if (aos_checksum != soa_checksum)
+	{
+		fprintf(stderr, "Checksums differ (%ld != %ld).\n", aos_checksum, soa_checksum);
+		return 2;
+	}
+
+	double job_units = (double)count * units;
+	printf("%d jobs, %d time units\n", count, units);
+	printf("  Array of structs: %.3f s (%.2f ns per job per time unit)\n", aos_time, aos_time * 1e9 / job_units);
+	printf("  Struct of arrays: %.3f s (%.2f ns per job per time unit)\n", soa_time, soa_time * 1e9 / job_units);
+	printf("  Speedup: %.2fx\n", aos_time / soa_time);
+
+	free(jobs);
+	free(arrival_time);
+	free(run_time);
+	free(priority);
+	free(core_id);
+
+	return 0;
+}
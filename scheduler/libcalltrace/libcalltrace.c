@@ -0,0 +1,145 @@
+/** @file libcalltrace.c
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "libcalltrace.h"
+
+#define CALLTRACE_MAGIC "SCHEDCT1"
+
+static const char *call_names[] = { "start_up", "new_jobs", "arrival", "job_finished", "quantum_expired", "job_blocked", "job_woke", "set_admission", "set_aging",
+                                     "set_quantum", "core_quantum" };
+
+
+static int calltrace_flush(calltrace_t *trace)
+{
+    int ok = fwrite(trace->mbuffer, sizeof(call_t), trace->mcount, trace->mfile) == (size_t)trace->mcount;
+    trace->mcount = 0;
+    return ok;
+}
+
+
+/**
+  Creates a trace file: an 8 byte header followed by call_t records, in the
+  machine's own binary layout.
+
+  @param trace a pointer to an instance of the calltrace_t data structure
+  @param file_name the file to write
+  @return 1 on success
+  @return 0 if the file could not be created
+ */
+int calltrace_open(calltrace_t *trace, const char *file_name)
+{
+    trace->mcount = 0;
+    trace->mcalls = 0;
+    trace->mfile = fopen(file_name, "wb");
+
+    if(trace->mfile == NULL)
+        return 0;
+    if(fwrite(CALLTRACE_MAGIC, 8, 1, trace->mfile) == 1)
+        return 1;
+
+    fclose(trace->mfile);
+    trace->mfile = NULL;
+    return 0;
+}
+
+
+/**
+  Appends a call to a trace. Calls are buffered, and only reach the file when the
+  buffer fills or the trace is closed.
+
+  @param trace a pointer to an instance of the calltrace_t data structure
+  @param type the call made
+  @param time the time passed to the call
+  @param a first argument other than time (see call_t)
+  @param b second argument other than time
+  @param c third argument other than time
+  @param result what the call returned
+ */
+void calltrace_write(calltrace_t *trace, call_type_t type, int time, int a, int b, int c, int result)
+{
+    call_t *call = &trace->mbuffer[trace->mcount++];
+
+    call->type = type;
+    call->time = time;
+    call->a = a;
+    call->b = b;
+    call->c = c;
+    call->result = result;
+    trace->mcalls++;
+
+    if(trace->mcount == CALLTRACE_BUFFER)
+        calltrace_flush(trace);
+}
+
+
+/**
+  Closes a trace, writing out any buffered calls first.
+
+  @param trace a pointer to an instance of the calltrace_t data structure
+  @return 1 on success
+  @return 0 if writing failed
+ */
+int calltrace_close(calltrace_t *trace)
+{
+    if(trace->mfile == NULL)
+        return 0;
+
+    int ok = calltrace_flush(trace);
+    ok = (fclose(trace->mfile) == 0) && ok;
+    trace->mfile = NULL;
+
+    return ok;
+}
+
+
+/**
+  Reads a whole trace into memory, so it can be replayed without any I/O.
+
+  @param file_name the trace file
+  @param count set to the number of records read
+  @return the records, to be released with free()
+  @return NULL if the file cannot be read, is not a trace or is cut short
+ */
+call_t *calltrace_load(const char *file_name, long *count)
+{
+    char magic[8];
+    call_t *calls = NULL;
+    long size;
+
+    FILE *file = fopen(file_name, "rb");
+    if(file == NULL)
+        return NULL;
+
+    if(fread(magic, 8, 1, file) == 1 && memcmp(magic, CALLTRACE_MAGIC, 8) == 0 &&
+       fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) >= 8 &&
+       (size - 8) % sizeof(call_t) == 0 && fseek(file, 8, SEEK_SET) == 0)
+    {
+        *count = (size - 8) / sizeof(call_t);
+        calls = malloc((*count > 0 ? *count : 1) * sizeof(call_t));
+
+        if(calls != NULL && fread(calls, sizeof(call_t), *count, file) != (size_t)*count)
+        {
+            free(calls);
+            calls = NULL;
+        }
+    }
+
+    fclose(file);
+    return calls;
+}
+
+
+/**
+  Returns the name of a call type.
+
+  @param type the call type
+  @return the name, e.g. "job_finished"
+ */
+const char *calltrace_type_name(call_type_t type)
+{
+    return call_names[type];
+}
@@ -0,0 +1,68 @@
+/** @file libcalltrace.h
+ */
+
+#ifndef LIBCALLTRACE_H_
+#define LIBCALLTRACE_H_
+
+#include <stdio.h>
+
+/**
+  Constants which represent the libscheduler calls that are recorded. A new jobs
+  call is followed by one CALL_ARRIVAL record per job in the batch.
+*/
+typedef enum {CALL_START_UP = 0, CALL_NEW_JOBS, CALL_ARRIVAL, CALL_JOB_FINISHED, CALL_QUANTUM_EXPIRED, CALL_JOB_BLOCKED, CALL_JOB_WOKE, CALL_SET_ADMISSION, CALL_SET_AGING,
+              CALL_SET_QUANTUM, CALL_CORE_QUANTUM} call_type_t;
+
+/**
+ *  Call Structure, also the record layout of trace files (24 bytes)
+ *  Member variables:
+ *      type = a call_type_t
+ *      time = the time passed to the call
+ *      a, b, c = the other arguments:
+ *          start up: cores, scheme
+ *          new jobs: number of jobs in the batch
+ *          arrival: job number, running time, priority
+ *          job finished: core, job number
+ *          quantum expired: core
+ *          job blocked: core, job number
+ *          job woke: job number
+ *          set admission: max queue, policy, deadline
+ *          set aging: interval
+ *          set quantum: latency, min quantum, max quantum
+ *          core quantum: core
+ *      result = what the call returned (arrival: the core the job was given, or SCHEDULER_REJECTED;
+ *          core quantum: the quantum)
+ */
+typedef struct _call_t
+{
+    int type;
+    int time;
+    int a, b, c;
+    int result;
+} call_t;
+
+#define CALLTRACE_BUFFER 4096
+
+/**
+ *  Call Trace Structure, used to record a trace
+ *  Member variables:
+ *      mfile = the open trace file
+ *      mbuffer = calls waiting to be written
+ *      mcount = the number of calls in mbuffer
+ *      mcalls = the number of records written so far
+ */
+typedef struct _calltrace_t
+{
+    FILE *mfile;
+    call_t mbuffer[CALLTRACE_BUFFER];
+    int mcount;
+    long mcalls;
+} calltrace_t;
+
+int         calltrace_open     (calltrace_t *trace, const char *file_name);
+void        calltrace_write    (calltrace_t *trace, call_type_t type, int time, int a, int b, int c, int result);
+int         calltrace_close    (calltrace_t *trace);
+call_t     *calltrace_load     (const char *file_name, long *count);
+const char *calltrace_type_name(call_type_t type);
+
+#endif /* LIBCALLTRACE_H_ */
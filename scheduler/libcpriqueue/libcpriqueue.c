@@ -0,0 +1,192 @@
+/** @file libcpriqueue.c
+ *
+ * A concurrent keyed priority queue for many producers and consumers, built as a
+ * relaxed multi-queue: the elements are spread over several shards, each a keyed
+ * priqueue_t behind its own lock. An offer goes to a random shard. A poll looks at
+ * the head keys of two random shards and takes the head of the better one.
+ *
+ * A poll is therefore not guaranteed to return the smallest key in the whole queue,
+ * only one of the smallest: with k shards the element returned is, on average,
+ * within about k positions of the true head. Equal keys are not kept in offer order.
+ * In exchange, threads rarely contend for the same lock, so throughput grows with
+ * the number of threads instead of collapsing onto a single lock.
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+
+#include "libcpriqueue.h"
+
+static _Thread_local unsigned long long rng_state;
+
+/*
+  xorshift64, one generator per thread, seeded from the address of its state
+*/
+static unsigned int cpriqueue_random()
+{
+    if(rng_state == 0)
+        rng_state = ((unsigned long long)(uintptr_t)&rng_state * 0x9E3779B97F4A7C15ULL) | 1;
+
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (unsigned int)(rng_state >> 32);
+}
+
+/*
+  Republishes the head key of a shard, must be called with the shard locked
+*/
+static void cpriqueue_update_top(cpriqueue_shard_t *shard)
+{
+    long long key;
+    if(!priqueue_peek_key(&shard->mqueue, &key))
+        key = LLONG_MAX;
+    atomic_store_explicit(&shard->mtop, key, memory_order_relaxed);
+}
+
+static long long cpriqueue_top(cpriqueue_shard_t *shard)
+{
+    return atomic_load_explicit(&shard->mtop, memory_order_relaxed);
+}
+
+
+/**
+  Initializes the cpriqueue_t data structure.
+
+  @param q a pointer to an instance of the cpriqueue_t data structure
+  @param shards the number of shards; a few per thread using the queue works well
+  @return 1 on success
+  @return 0 if shards is not positive or out of memory
+ */
+int cpriqueue_init(cpriqueue_t *q, int shards)
+{
+    if(shards <= 0)
+        return 0;
+
+    q->mshards = aligned_alloc(64, shards * sizeof(cpriqueue_shard_t));
+    if(q->mshards == NULL)
+        return 0;
+
+    for(int i = 0; i < shards; i++)
+    {
+        pthread_mutex_init(&q->mshards[i].mlock, NULL);
+        priqueue_init_keyed(&q->mshards[i].mqueue);
+        atomic_init(&q->mshards[i].mtop, LLONG_MAX);
+    }
+    q->mcount = shards;
+    atomic_init(&q->msize, 0);
+
+    return 1;
+}
+
+
+/**
+  Inserts an element. Safe to call from any number of threads at once.
+
+  @param q a pointer to an instance of the cpriqueue_t data structure
+  @param ptr the element, which must not be NULL
+  @param key the sort key of ptr, lowest first
+ */
+void cpriqueue_offer(cpriqueue_t *q, void *ptr, long long key)
+{
+    cpriqueue_shard_t *shard;
+    int attempt = 0;
+
+    //any shard will do, so try another rather than wait for a busy one (but not forever)
+    do {
+        shard = &q->mshards[cpriqueue_random() % q->mcount];
+    } while(++attempt < q->mcount && pthread_mutex_trylock(&shard->mlock) != 0);
+    if(attempt == q->mcount)
+        pthread_mutex_lock(&shard->mlock);
+
+    priqueue_offer_keyed(&shard->mqueue, ptr, key);
+    if(key < cpriqueue_top(shard))
+        atomic_store_explicit(&shard->mtop, key, memory_order_relaxed);
+
+    pthread_mutex_unlock(&shard->mlock);
+    atomic_fetch_add(&q->msize, 1);
+}
+
+
+/**
+  Removes and returns an element with one of the smallest keys (see the top of
+  this file for how relaxed). Safe to call from any number of threads at once.
+
+  @param q a pointer to an instance of the cpriqueue_t data structure
+  @return the element
+  @return NULL if the queue is empty
+ */
+void *cpriqueue_poll(cpriqueue_t *q)
+{
+    for(int attempt = 0; atomic_load(&q->msize) > 0; attempt++)
+    {
+        cpriqueue_shard_t *shard = &q->mshards[cpriqueue_random() % q->mcount];
+        cpriqueue_shard_t *other = &q->mshards[cpriqueue_random() % q->mcount];
+
+        if(cpriqueue_top(other) < cpriqueue_top(shard))
+            shard = other;
+
+        //when random picks keep missing (few elements left, or a lot of contention),
+        //take the best head of all the shards and wait for its lock
+        int patient = attempt >= q->mcount;
+        if(patient)
+        {
+            for(int i = 0; i < q->mcount; i++)
+                if(cpriqueue_top(&q->mshards[i]) < cpriqueue_top(shard))
+                    shard = &q->mshards[i];
+        }
+
+        if(cpriqueue_top(shard) == LLONG_MAX)
+            continue;
+        if(patient)
+            pthread_mutex_lock(&shard->mlock);
+        else if(pthread_mutex_trylock(&shard->mlock) != 0)
+            continue;
+
+        //the shard may have been emptied since its head key was read
+        void *ptr = priqueue_poll(&shard->mqueue);
+        cpriqueue_update_top(shard);
+        pthread_mutex_unlock(&shard->mlock);
+
+        if(ptr != NULL)
+        {
+            atomic_fetch_sub(&q->msize, 1);
+            return ptr;
+        }
+    }
+
+    return NULL;
+}
+
+
+/**
+  Returns the number of elements in the queue. While other threads are offering
+  or polling this is only a snapshot.
+
+  @param q a pointer to an instance of the cpriqueue_t data structure
+  @return the number of elements in the queue
+ */
+int cpriqueue_size(cpriqueue_t *q)
+{
+    return atomic_load(&q->msize);
+}
+
+
+/**
+  Destroys and frees all the memory associated with q. No other thread may be
+  using the queue.
+
+  @param q a pointer to an instance of the cpriqueue_t data structure
+ */
+void cpriqueue_destroy(cpriqueue_t *q)
+{
+    for(int i = 0; i < q->mcount; i++)
+    {
+        pthread_mutex_destroy(&q->mshards[i].mlock);
+        priqueue_destroy(&q->mshards[i].mqueue);
+    }
+    free(q->mshards);
+    q->mshards = NULL;
+    q->mcount = 0;
+}
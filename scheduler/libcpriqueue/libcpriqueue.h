@@ -0,0 +1,50 @@
+/** @file libcpriqueue.h
+ */
+
+#ifndef LIBCPRIQUEUE_H_
+#define LIBCPRIQUEUE_H_
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "../libpriqueue/libpriqueue.h"
+
+/**
+ *  Shard Structure, one keyed priqueue and its lock, padded to a cache line of its
+ *  own so threads working on neighbouring shards do not slow each other down
+ *  Member variables:
+ *      mlock = held while mqueue is read or changed
+ *      mqueue = the shard's elements
+ *      mtop = the key at the head of mqueue, LLONG_MAX if it is empty. Written
+ *             under mlock but read without it, to choose a shard to poll.
+ */
+typedef struct _cpriqueue_shard_t
+{
+    pthread_mutex_t mlock;
+    priqueue_t mqueue;
+    _Atomic long long mtop;
+
+} __attribute__((aligned(64))) cpriqueue_shard_t;
+
+/**
+ *  Concurrent Priqueue Data Structure
+ *  Member variables:
+ *      mshards = the shards
+ *      mcount = the number of shards
+ *      msize = the number of elements in all the shards
+ */
+typedef struct _cpriqueue_t
+{
+    cpriqueue_shard_t *mshards;
+    int mcount;
+    _Atomic int msize;
+
+} cpriqueue_t;
+
+int    cpriqueue_init    (cpriqueue_t *q, int shards);
+void   cpriqueue_offer   (cpriqueue_t *q, void *ptr, long long key);
+void * cpriqueue_poll    (cpriqueue_t *q);
+int    cpriqueue_size    (cpriqueue_t *q);
+void   cpriqueue_destroy (cpriqueue_t *q);
+
+#endif /* LIBCPRIQUEUE_H_ */
@@ -0,0 +1,239 @@
+/** @file libeventlog.c
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "libeventlog.h"
+
+#define EVENTLOG_MAGIC "SCHEDEV1"
+
+static const char *event_names[] = { "arrival", "dispatch", "preempt", "expire", "finish", "block", "wake", "reject", "shed" };
+
+
+/*
+  Logs whose file name ends in .jsonl (or .json) are JSON lines, anything else is binary
+*/
+static int eventlog_is_json(const char *file_name)
+{
+    const char *dot = strrchr(file_name, '.');
+    return dot != NULL && (strcmp(dot, ".jsonl") == 0 || strcmp(dot, ".json") == 0);
+}
+
+static int eventlog_flush(eventlog_t *log)
+{
+    int ok = 1;
+
+    if(log->mjson)
+    {
+        for(int i = 0; i < log->mcount && ok; i++)
+        {
+            event_t *e = &log->mbuffer[i];
+            ok = fprintf(log->mfile, "{\"t\":%d,\"ev\":\"%s\",\"core\":%d,\"job\":%d}\n",
+                         e->time, event_names[e->type], e->core, e->job) > 0;
+        }
+    }
+    else if(log->mcount > 0)
+        ok = fwrite(log->mbuffer, sizeof(event_t), log->mcount, log->mfile) == (size_t)log->mcount;
+
+    log->mcount = 0;
+    return ok;
+}
+
+/*
+  Refills the buffer of a log being read. Returns the number of events now buffered,
+  0 at the end of the log and -1 if the log is malformed. The events before a
+  malformed record are buffered first, so a log cut short by a crash can still be
+  read up to where it stops.
+*/
+static int eventlog_fill(eventlog_t *log)
+{
+    log->mcount = 0;
+    log->mnext = 0;
+
+    if(log->mbroken)
+        return -1;
+
+    if(!log->mjson)
+    {
+        size_t got = fread(log->mbuffer, sizeof(event_t), EVENTLOG_BUFFER, log->mfile);
+        if(got < EVENTLOG_BUFFER && !feof(log->mfile))
+            log->mbroken = 1;
+        //a partial record at the end means the log was cut short
+        else if(got < EVENTLOG_BUFFER && (ftell(log->mfile) - 8) % sizeof(event_t) != 0)
+            log->mbroken = 1;
+        for(size_t i = 0; i < got; i++)
+            if(log->mbuffer[i].type > EVENT_SHED)
+            {
+                log->mbroken = 1;
+                got = i;
+                break;
+            }
+        log->mcount = got;
+        return log->mcount == 0 && log->mbroken ? -1 : log->mcount;
+    }
+
+    char line[128];
+    while(log->mcount < EVENTLOG_BUFFER && fgets(line, sizeof(line), log->mfile) != NULL)
+    {
+        event_t *e = &log->mbuffer[log->mcount];
+        char name[16];
+        int time, core, job, type;
+
+        if(sscanf(line, "{\"t\":%d,\"ev\":\"%15[a-z]\",\"core\":%d,\"job\":%d}", &time, name, &core, &job) != 4)
+        {
+            log->mbroken = 1;
+            break;
+        }
+        for(type = EVENT_ARRIVAL; type <= EVENT_SHED; type++)
+            if(strcmp(name, event_names[type]) == 0)
+                break;
+        if(type > EVENT_SHED)
+        {
+            log->mbroken = 1;
+            break;
+        }
+
+        memset(e, 0, sizeof(event_t));
+        e->time = time;
+        e->type = type;
+        e->core = core;
+        e->job = job;
+        log->mcount++;
+    }
+    return log->mcount == 0 && log->mbroken ? -1 : log->mcount;
+}
+
+
+/**
+  Opens an event log. The format is chosen by the file name: JSON lines if it ends
+  in .jsonl, otherwise a binary stream of event_t records after an 8 byte header.
+
+  @param log a pointer to an instance of the eventlog_t data structure
+  @param file_name the file to write or read
+  @param writing 1 to create the log, 0 to read it
+  @return 1 on success
+  @return 0 if the file could not be opened, or is not an event log
+ */
+int eventlog_open(eventlog_t *log, const char *file_name, int writing)
+{
+    log->mjson = eventlog_is_json(file_name);
+    log->mwriting = writing;
+    log->mcount = 0;
+    log->mnext = 0;
+    log->mevents = 0;
+    log->mbroken = 0;
+    log->mfile = fopen(file_name, writing ? "w" : "r");
+
+    if(log->mfile == NULL)
+        return 0;
+
+    if(log->mjson)
+        return 1;
+
+    char magic[8];
+    if(writing ? fwrite(EVENTLOG_MAGIC, 8, 1, log->mfile) == 1
+               : fread(magic, 8, 1, log->mfile) == 1 && memcmp(magic, EVENTLOG_MAGIC, 8) == 0)
+        return 1;
+
+    fclose(log->mfile);
+    log->mfile = NULL;
+    return 0;
+}
+
+
+/**
+  Appends an event to a log opened for writing. Events are buffered, and only
+  reach the file when the buffer fills or the log is closed.
+
+  @param log a pointer to an instance of the eventlog_t data structure
+  @param time the time unit of the event
+  @param type the kind of event
+  @param core the core involved, or -1
+  @param job the job involved
+ */
+void eventlog_write(eventlog_t *log, int time, event_type_t type, int core, int job)
+{
+    event_t *e = &log->mbuffer[log->mcount++];
+
+    e->time = time;
+    e->job = job;
+    e->core = core;
+    e->type = type;
+    e->pad = 0;
+    log->mevents++;
+
+    if(log->mcount == EVENTLOG_BUFFER)
+        eventlog_flush(log);
+}
+
+
+/**
+  Reads the next event of a log opened for reading.
+
+  @param log a pointer to an instance of the eventlog_t data structure
+  @param event set to the event read
+  @return 1 if an event was read
+  @return 0 at the end of the log
+  @return -1 if the log is malformed
+ */
+int eventlog_read(eventlog_t *log, event_t *event)
+{
+    if(log->mnext == log->mcount)
+    {
+        int got = eventlog_fill(log);
+        if(got <= 0)
+            return got;
+    }
+
+    *event = log->mbuffer[log->mnext++];
+    log->mevents++;
+    return 1;
+}
+
+
+/**
+  Closes a log, writing out any buffered events first.
+
+  @param log a pointer to an instance of the eventlog_t data structure
+  @return 1 on success
+  @return 0 if writing failed
+ */
+int eventlog_close(eventlog_t *log)
+{
+    int ok = 1;
+
+    if(log->mfile == NULL)
+        return 0;
+    if(log->mwriting)
+        ok = eventlog_flush(log);
+    ok = (fclose(log->mfile) == 0) && ok;
+    log->mfile = NULL;
+
+    return ok;
+}
+
+
+/**
+  Returns the name of an event type, as used in JSON lines logs.
+
+  @param type the event type
+  @return the name, e.g. "dispatch"
+ */
+const char *eventlog_type_name(event_type_t type)
+{
+    return event_names[type];
+}
+
+
+/**
+  Prints an event on one line, in words.
+
+  @param event the event
+  @param out the stream to print to
+ */
+void eventlog_print(const event_t *event, FILE *out)
+{
+    fprintf(out, "time %d: %s of job %d on core %d", event->time, event_names[event->type], event->job, event->core);
+}
@@ -0,0 +1,65 @@
+/** @file libeventlog.h
+ */
+
+#ifndef LIBEVENTLOG_H_
+#define LIBEVENTLOG_H_
+
+#include <stdio.h>
+
+/**
+  Constants which represent the scheduling events that are logged
+*/
+typedef enum {EVENT_ARRIVAL = 0, EVENT_DISPATCH, EVENT_PREEMPT, EVENT_EXPIRE, EVENT_FINISH, EVENT_BLOCK, EVENT_WAKE, EVENT_REJECT, EVENT_SHED} event_type_t;
+
+/**
+ *  Event Structure, also the record layout of binary logs (12 bytes)
+ *  Member variables:
+ *      time = the time unit the event happened in
+ *      job = the job the event happened to
+ *      core = the core involved, -1 for an arrival or wakeup left waiting, a rejection or a shed job
+ *      type = an event_type_t
+ */
+typedef struct _event_t
+{
+    int time;
+    int job;
+    short core;
+    unsigned char type;
+    unsigned char pad;
+} event_t;
+
+#define EVENTLOG_BUFFER 4096
+
+/**
+ *  Event Log Structure
+ *  Member variables:
+ *      mfile = the open log file
+ *      mjson = 1 if the log is JSON lines, 0 if it is binary
+ *      mwriting = 1 if the log was opened for writing
+ *      mbuffer = events waiting to be written, or read but not yet handed out
+ *      mcount = the number of events in mbuffer
+ *      mnext = the next event of mbuffer to hand out (reading only)
+ *      mevents = the number of events written or read so far
+ *      mbroken = 1 once reading has reached a malformed record, which is only reported
+ *                after the events before it have been handed out
+ */
+typedef struct _eventlog_t
+{
+    FILE *mfile;
+    int mjson;
+    int mwriting;
+    event_t mbuffer[EVENTLOG_BUFFER];
+    int mcount;
+    int mnext;
+    long mevents;
+    int mbroken;
+} eventlog_t;
+
+int         eventlog_open     (eventlog_t *log, const char *file_name, int writing);
+void        eventlog_write    (eventlog_t *log, int time, event_type_t type, int core, int job);
+int         eventlog_read     (eventlog_t *log, event_t *event);
+int         eventlog_close    (eventlog_t *log);
+const char *eventlog_type_name(event_type_t type);
+void        eventlog_print    (const event_t *event, FILE *out);
+
+#endif /* LIBEVENTLOG_H_ */
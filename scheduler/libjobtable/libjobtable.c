@@ -0,0 +1,222 @@
+/** @file libjobtable.c
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "libjobtable.h"
+
+#define JOBTABLE_LINE 64
+
+/*
+  Moves a column into a new block of room for capacity rows, aligned to a cache line
+*/
+static int jobtable_grow_column(int **column, int count, int capacity)
+{
+    size_t size = (capacity * sizeof(int) + JOBTABLE_LINE - 1) / JOBTABLE_LINE * JOBTABLE_LINE;
+    int *grown = aligned_alloc(JOBTABLE_LINE, size);
+
+    if(grown == NULL)
+        return 0;
+    if(count > 0)
+        memcpy(grown, *column, count * sizeof(int));
+    free(*column);
+    *column = grown;
+    return 1;
+}
+
+static int jobtable_resize(jobtable_t *t, int capacity)
+{
+    int **columns[] = { &t->mjob_id, &t->marrival_time, &t->mrunning_time, &t->mpriority, &t->mcores };
+    int words = (t->mcapacity + 63) / 64, grown_words = (capacity + 63) / 64;
+
+    for(unsigned int i = 0; i < sizeof(columns) / sizeof(columns[0]); i++)
+        if(!jobtable_grow_column(columns[i], t->mcount, capacity))
+            return 0;
+
+    unsigned long long *mask = realloc(t->mfree_mask, grown_words * sizeof(unsigned long long));
+    if(mask == NULL)
+        return 0;
+    memset(mask + words, 0, (grown_words - words) * sizeof(unsigned long long));
+    t->mfree_mask = mask;
+
+    t->mcapacity = capacity;
+    return 1;
+}
+
+/**
+  Initializes the jobtable_t data structure, empty.
+  @param t a pointer to an instance of the jobtable_t data structure
+  @param capacity the number of rows to make room for to begin with, at least 1
+  @return 1 on success, 0 if out of memory (t is still to be destroyed)
+ */
+int jobtable_init(jobtable_t *t, int capacity)
+{
+    memset(t, 0, sizeof(jobtable_t));
+    return jobtable_resize(t, capacity > 0 ? capacity : 1);
+}
+
+/**
+  Adds a job, in the lowest free row.
+  @param t a pointer to an instance of the jobtable_t data structure
+  @param job_id the job number, at least 0.
+  @param arrival_time the time the job arrived, at least 0.
+  @param running_time the CPU time the job arrived with.
+  @param priority the priority of the job.
+  @param cores the number of cores the job needs at once.
+  @return the row of the job
+  @return -1 if out of memory
+ */
+int jobtable_add(jobtable_t *t, int job_id, int arrival_time, int running_time, int priority, int cores)
+{
+    int row = -1, words = (t->mcount + 63) / 64;
+
+    for(; t->mfree_hint < words; t->mfree_hint++)
+    {
+        if(t->mfree_mask[t->mfree_hint] != 0)
+        {
+            row = t->mfree_hint * 64 + __builtin_ctzll(t->mfree_mask[t->mfree_hint]);
+            t->mfree_mask[t->mfree_hint] &= ~(1ULL << (row % 64));
+            break;
+        }
+    }
+
+    if(row == -1)
+    {
+        if(t->mcount == t->mcapacity && !jobtable_resize(t, t->mcapacity * 2))
+            return -1;
+        row = t->mcount++;
+    }
+
+    t->mjob_id[row] = job_id;
+    t->marrival_time[row] = arrival_time;
+    t->mrunning_time[row] = running_time;
+    t->mpriority[row] = priority;
+    t->mcores[row] = cores;
+    t->mlive++;
+    return row;
+}
+
+/**
+  Takes a job out of the table, leaving its row free. No other row moves, but
+  mcount drops back past the free rows at the end of the table.
+  @param t a pointer to an instance of the jobtable_t data structure
+  @param row the row of the job, which must be in use.
+ */
+void jobtable_remove(jobtable_t *t, int row)
+{
+    t->mjob_id[row] = -1;
+    t->marrival_time[row] = -1;
+    t->mrunning_time[row] = -1;
+    t->mlive--;
+
+    if(row < t->mcount - 1)
+    {
+        t->mfree_mask[row / 64] |= 1ULL << (row % 64);
+        if(row / 64 < t->mfree_hint)
+            t->mfree_hint = row / 64;
+        return;
+    }
+
+    for(t->mcount--; t->mcount > 0 && t->mjob_id[t->mcount - 1] == -1; t->mcount--)
+        t->mfree_mask[(t->mcount - 1) / 64] &= ~(1ULL << ((t->mcount - 1) % 64));
+}
+
+/**
+  Makes dst a copy of src, every job in the same row and the same rows free.
+  @param dst a pointer to an instance of the jobtable_t data structure, initialized
+  by jobtable_init().
+  @param src the table to copy.
+  @return 1 on success, 0 if out of memory
+ */
+int jobtable_copy(jobtable_t *dst, const jobtable_t *src)
+{
+    if(dst->mcapacity < src->mcount && !jobtable_resize(dst, src->mcount))
+        return 0;
+
+    int *dst_columns[] = { dst->mjob_id, dst->marrival_time, dst->mrunning_time, dst->mpriority, dst->mcores };
+    const int *src_columns[] = { src->mjob_id, src->marrival_time, src->mrunning_time, src->mpriority, src->mcores };
+
+    int words = (src->mcount + 63) / 64;
+
+    for(unsigned int i = 0; i < sizeof(dst_columns) / sizeof(dst_columns[0]); i++)
+        memcpy(dst_columns[i], src_columns[i], src->mcount * sizeof(int));
+    memset(dst->mfree_mask, 0, (dst->mcapacity + 63) / 64 * sizeof(unsigned long long));
+    memcpy(dst->mfree_mask, src->mfree_mask, words * sizeof(unsigned long long));
+
+    dst->mfree_hint = src->mfree_hint;
+    dst->mcount = src->mcount;
+    dst->mlive = src->mlive;
+    return 1;
+}
+
+/**
+  Writes the table to a file, in the machine's own binary layout. The free rows
+  are not written, they are the ones whose job number is -1.
+  @param t a pointer to an instance of the jobtable_t data structure
+  @param file an open file to write it to.
+  @return 1 on success, 0 if writing failed
+ */
+int jobtable_write(const jobtable_t *t, FILE *file)
+{
+    int header[] = { t->mcount, t->mlive };
+    const int *columns[] = { t->mjob_id, t->marrival_time, t->mrunning_time, t->mpriority, t->mcores };
+    size_t count = t->mcount;
+
+    if(fwrite(header, sizeof(header), 1, file) != 1)
+        return 0;
+    for(unsigned int i = 0; i < sizeof(columns) / sizeof(columns[0]); i++)
+        if(fwrite(columns[i], sizeof(int), count, file) != count)
+            return 0;
+    return 1;
+}
+
+/**
+  Reads a table written by jobtable_write().
+  @param t a pointer to the jobtable_t data structure to fill in; it is to be
+  destroyed whether reading succeeds or not.
+  @param file an open file to read it from.
+  @return 1 on success, 0 if the file is truncated or corrupt, or out of memory
+ */
+int jobtable_read(jobtable_t *t, FILE *file)
+{
+    int header[2];
+
+    memset(t, 0, sizeof(jobtable_t));
+    if(fread(header, sizeof(header), 1, file) != 1 || header[0] < 0 || header[1] < 0 || header[1] > header[0] ||
+       !jobtable_init(t, header[0] > 16 ? header[0] : 16))
+        return 0;
+
+    int *columns[] = { t->mjob_id, t->marrival_time, t->mrunning_time, t->mpriority, t->mcores };
+    size_t count = header[0];
+
+    for(unsigned int i = 0; i < sizeof(columns) / sizeof(columns[0]); i++)
+        if(fread(columns[i], sizeof(int), count, file) != count)
+            return 0;
+
+    for(int row = 0; row < header[0]; row++)
+    {
+        if(t->mjob_id[row] == -1)
+            t->mfree_mask[row / 64] |= 1ULL << (row % 64);
+        else
+            t->mlive++;
+    }
+
+    t->mcount = header[0];
+    return t->mlive == header[1] && (t->mcount == 0 || t->mjob_id[t->mcount - 1] != -1);
+}
+
+/**
+  Frees all the memory of the table.
+  @param t a pointer to an instance of the jobtable_t data structure
+ */
+void jobtable_destroy(jobtable_t *t)
+{
+    free(t->mjob_id);
+    free(t->marrival_time);
+    free(t->mrunning_time);
+    free(t->mpriority);
+    free(t->mcores);
+    free(t->mfree_mask);
+    memset(t, 0, sizeof(jobtable_t));
+}
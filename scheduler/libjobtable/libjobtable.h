@@ -0,0 +1,53 @@
+/** @file libjobtable.h
+ */
+
+#ifndef LIBJOBTABLE_H_
+#define LIBJOBTABLE_H_
+
+#include <stdio.h>
+
+/**
+ *  Job Table Structure, what is known about each job when it arrives, one row per
+ *  job kept as a struct of arrays. The simulator owns the table and libscheduler
+ *  works on row numbers into it (see scheduler_set_job_table()), so a job's data
+ *  is stored once. A row keeps its number for as long as the job is in the table:
+ *  a job taken out leaves its row free, and a new job is given the lowest free row,
+ *  so the rows in use stay packed at the start of the table and a pass over the
+ *  first mcount rows sees every job. Every column starts on a cache line.
+ *
+ *  Member variables:
+ *      mjob_id = the job number in each row, -1 for a free row
+ *      marrival_time = the time the job arrived, -1 for a free row
+ *      mrunning_time = the CPU time the job arrived with, -1 for a free row
+ *      mpriority = the priority of the job (the lower the value, the higher the priority)
+ *      mcores = the number of cores the job needs at once
+ *      mfree_mask = a bit for each free row below mcount
+ *      mfree_hint = every word of mfree_mask before it is known to be all zero
+ *      mcount = the number of rows up to the last one in use, every row after it is free
+ *      mcapacity = the number of rows there is room for
+ *      mlive = the number of rows in use
+ */
+typedef struct _jobtable_t
+{
+    int *mjob_id;
+    int *marrival_time;
+    int *mrunning_time;
+    int *mpriority;
+    int *mcores;
+    unsigned long long *mfree_mask;
+    int mfree_hint;
+    int mcount;
+    int mcapacity;
+    int mlive;
+
+} jobtable_t;
+
+int  jobtable_init    (jobtable_t *t, int capacity);
+int  jobtable_add     (jobtable_t *t, int job_id, int arrival_time, int running_time, int priority, int cores);
+void jobtable_remove  (jobtable_t *t, int row);
+int  jobtable_copy    (jobtable_t *dst, const jobtable_t *src);
+int  jobtable_write   (const jobtable_t *t, FILE *file);
+int  jobtable_read    (jobtable_t *t, FILE *file);
+void jobtable_destroy (jobtable_t *t);
+
+#endif /* LIBJOBTABLE_H_ */
@@ -0,0 +1,439 @@
+/** @file liblive.c
+ *
+ * Runs a set of jobs for real under libscheduler's decisions, instead of simulating
+ * them. Every core is a thread, pinned to a CPU where possible, and every job is a
+ * CPU-bound loop sized to take its running time, where one time unit is unit_ns of
+ * wall time on this machine (calibrated before the run).
+ *
+ * A core works on its job in slices of 1/LIVE_SLICES_PER_UNIT of a time unit, and the
+ * end of each slice is a yield point: the job's progress is recorded, the quantum is
+ * checked, and the core notices if an arrival has preempted its job. A preempted
+ * core throws away the slice it was in the middle of, as the job may already have
+ * been given to another core.
+ *
+ * libscheduler is not thread safe, so every call to it, and every change to the
+ * jobs and cores, is made holding one lock. The times passed to it are the wall
+ * time in whole time units.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "liblive.h"
+#include "../libscheduler/libscheduler.h"
+
+#define LIVE_SLICES_PER_UNIT 8
+
+struct _live_t;
+
+/**
+ *  Live Core Structure
+ *  Member variables:
+ *      mthread = the thread doing the core's work
+ *      mwake = signalled when an idle core is given a job, or the run stops
+ *      mid = the core id
+ *      mjob = the job the scheduler has put on this core, -1 when idle
+ *      mlive = the run the core belongs to
+ */
+typedef struct _live_core_t
+{
+    pthread_t mthread;
+    pthread_cond_t mwake;
+    int mid;
+    int mjob;
+    struct _live_t *mlive;
+
+} live_core_t;
+
+/**
+ *  Live Run Structure
+ *  Member variables:
+ *      mlock = held around every libscheduler call and every change to the jobs or cores
+ *      mdone = signalled when the last job finishes, or the run fails
+ *      mcores, mcount = the cores
+ *      mjobs, mjobs_ct = the jobs, indexed by job id
+ *      malive = the number of jobs released but not finished
+ *      mfinished = the number of jobs finished
+ *      mfailed = set when the scheduler makes an invalid decision or leaves jobs waiting on idle cores
+ *      mstop = set to make the core threads return
+ *      mscheme, mquantum = the scheme, and the RR quantum in time units
+ *      munit = the length of a time unit in ns
+ *      mstart = the start of the run on the monotonic clock, in ns
+ *      mtime = the last time passed to libscheduler, in time units
+ *      mslice = the number of spin loop iterations in one slice
+ *      mlost = the number of slices thrown away by preempted cores
+ */
+typedef struct _live_t
+{
+    pthread_mutex_t mlock;
+    pthread_cond_t mdone;
+    live_core_t *mcores;
+    int mcount;
+    live_job_t *mjobs;
+    int mjobs_ct;
+    int malive;
+    int mfinished;
+    int mfailed;
+    int mstop;
+    int mscheme, mquantum;
+    long long munit;
+    long long mstart;
+    int mtime;
+    unsigned long mslice;
+    long mlost;
+
+} live_t;
+
+
+static long long live_clock()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static long long live_now(live_t *live)
+{
+    return live_clock() - live->mstart;
+}
+
+/*
+  The time to pass to libscheduler, never going backwards. Must be called holding mlock.
+*/
+static int live_time(live_t *live, long long now)
+{
+    int time = now / live->munit;
+
+    if(time > live->mtime)
+        live->mtime = time;
+    return live->mtime;
+}
+
+/*
+  The work itself, an LCG the compiler is not allowed to see through
+*/
+static unsigned long live_spin(unsigned long iterations, unsigned long x)
+{
+    while(iterations-- > 0)
+    {
+        x = x * 6364136223846793005UL + 1442695040888963407UL;
+        __asm__ volatile("" : "+r"(x));
+    }
+    return x;
+}
+
+/*
+  Finds the number of iterations in one slice, by doubling until a run takes 20 ms
+*/
+static unsigned long live_calibrate(long long unit_ns)
+{
+    unsigned long iterations = 1024, x = 1;
+    long long elapsed;
+
+    for(;;)
+    {
+        long long start = live_clock();
+        x = live_spin(iterations, x);
+        elapsed = live_clock() - start;
+
+        if(elapsed >= 20000000LL)
+            break;
+        iterations *= 2;
+    }
+
+    unsigned long slice = (double)iterations / elapsed * unit_ns / LIVE_SLICES_PER_UNIT;
+
+    return slice > 0 ? slice : 1;
+}
+
+/*
+  Fails the run if the scheduler has left released jobs waiting with every core
+  idle, as the simulator does. Must be called holding mlock.
+*/
+static void live_check_idle(live_t *live)
+{
+    for(int i = 0; i < live->mcount; i++)
+        if(live->mcores[i].mjob != -1)
+            return;
+
+    if(live->malive > 0)
+    {
+        live->mfailed = 1;
+        pthread_cond_signal(&live->mdone);
+    }
+}
+
+/*
+  Puts the job the scheduler chose on a core, checking it is one that has been
+  released and not finished. Must be called holding mlock.
+*/
+static void live_assign(live_t *live, int core_id, int job_id)
+{
+    if(job_id < -1 || job_id >= live->mjobs_ct ||
+       (job_id != -1 && (live->mjobs[job_id].released < 0 || live->mjobs[job_id].finished >= 0)))
+    {
+        live->mfailed = 1;
+        pthread_cond_signal(&live->mdone);
+        job_id = -1;
+    }
+
+    live->mcores[core_id].mjob = job_id;
+    if(job_id != -1)
+        pthread_cond_signal(&live->mcores[core_id].mwake);
+}
+
+static void *live_core_run(void *arg)
+{
+    live_core_t *core = arg;
+    live_t *live = core->mlive;
+    unsigned long sink = core->mid;
+
+    pthread_mutex_lock(&live->mlock);
+    while(!live->mstop && !live->mfailed)
+    {
+        if(core->mjob == -1)
+        {
+            pthread_cond_wait(&core->mwake, &live->mlock);
+            continue;
+        }
+
+        int index = core->mjob;
+        live_job_t *job = &live->mjobs[index];
+        long long dispatched = live_now(live), credited = dispatched;
+
+        if(job->first_run < 0)
+            job->first_run = dispatched;
+        pthread_mutex_unlock(&live->mlock);
+
+        for(;;)
+        {
+            sink = live_spin(live->mslice, sink);
+            long long now = live_now(live);
+
+            // Yield point
+            pthread_mutex_lock(&live->mlock);
+            if(live->mstop || live->mfailed)
+                break;
+
+            if(core->mjob != index)
+            {
+                live->mlost++;
+                job->ran += credited - dispatched;
+                break;
+            }
+
+            credited = now;
+            if(--job->slices <= 0)
+            {
+                job->finished = now;
+                job->ran += now - dispatched;
+                live->malive--;
+                live->mfinished++;
+
+                live_assign(live, core->mid, scheduler_job_finished(core->mid, job->job_id, live_time(live, now)));
+                if(live->mfinished == live->mjobs_ct)
+                    pthread_cond_signal(&live->mdone);
+                live_check_idle(live);
+                break;
+            }
+
+            if(live->mscheme == RR && now - dispatched >= live->mquantum * live->munit)
+            {
+                job->ran += now - dispatched;
+                live_assign(live, core->mid, scheduler_quantum_expired(core->mid, live_time(live, now)));
+                live_check_idle(live);
+                break;
+            }
+            pthread_mutex_unlock(&live->mlock);
+        }
+    }
+    pthread_mutex_unlock(&live->mlock);
+
+    return (void *)sink;
+}
+
+static int live_compare_arrivals(const void *a, const void *b)
+{
+    const live_job_t *x = *(live_job_t * const *)a, *y = *(live_job_t * const *)b;
+
+    if(x->arrival_time != y->arrival_time)
+        return x->arrival_time - y->arrival_time;
+    return x->job_id - y->job_id;
+}
+
+/*
+  Pins a core thread to a CPU, spreading the cores over the CPUs online
+*/
+static int live_pin(pthread_t thread, int core_id, int cpus)
+{
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+    CPU_SET(core_id % cpus, &set);
+    return pthread_setaffinity_np(thread, sizeof(cpu_set_t), &set) == 0;
+}
+
+
+/**
+  Runs jobs for real, one thread per core, under the scheme's decisions, and
+  measures how long they really wait. Calls scheduler_start_up() and
+  scheduler_clean_up() itself.
+
+  @param jobs the jobs, where jobs[i].job_id must be i; their times are filled in
+  @param count the number of jobs
+  @param cores the number of cores
+  @param scheme the scheme, as passed to scheduler_start_up()
+  @param quantum the RR quantum in time units
+  @param unit_ns the wall time one time unit stands for, in ns
+  @param result filled in with the measured averages
+  @return 1 on success
+  @return 0 if the core threads could not be started
+  @return -1 if the scheduler chose an invalid job or left jobs waiting with every core idle
+ */
+int live_run(live_job_t *jobs, int count, int cores, int scheme, int quantum, long long unit_ns, live_result_t *result)
+{
+    live_t live;
+    live_job_t **order = malloc((count > 0 ? count : 1) * sizeof(live_job_t *));
+    int i, j, started = 0;
+
+    memset(result, 0, sizeof(live_result_t));
+    memset(&live, 0, sizeof(live_t));
+    live.mcores = calloc(cores, sizeof(live_core_t));
+    scheduler_arrival_t *batch = malloc((count > 0 ? count : 1) * sizeof(scheduler_arrival_t));
+
+    if(order == NULL || live.mcores == NULL || batch == NULL)
+    {
+        free(order);
+        free(live.mcores);
+        free(batch);
+        return 0;
+    }
+
+    pthread_mutex_init(&live.mlock, NULL);
+    pthread_cond_init(&live.mdone, NULL);
+    live.mcount = cores;
+    live.mjobs = jobs;
+    live.mjobs_ct = count;
+    live.mscheme = scheme;
+    live.mquantum = quantum;
+    live.munit = unit_ns;
+    live.mslice = live_calibrate(unit_ns);
+
+    for(i = 0; i < count; i++)
+    {
+        jobs[i].released = jobs[i].first_run = jobs[i].finished = -1;
+        jobs[i].ran = 0;
+        jobs[i].slices = jobs[i].run_time * LIVE_SLICES_PER_UNIT;
+        order[i] = &jobs[i];
+    }
+    qsort(order, count, sizeof(live_job_t *), live_compare_arrivals);
+
+    result->cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if(result->cpus < 1)
+        result->cpus = 1;
+
+    scheduler_start_up(cores, scheme);
+    live.mstart = live_clock();
+
+    pthread_mutex_lock(&live.mlock);
+    for(i = 0; i < cores; i++)
+    {
+        live.mcores[i].mid = i;
+        live.mcores[i].mjob = -1;
+        live.mcores[i].mlive = &live;
+        pthread_cond_init(&live.mcores[i].mwake, NULL);
+
+        if(pthread_create(&live.mcores[i].mthread, NULL, live_core_run, &live.mcores[i]) != 0)
+        {
+            live.mfailed = 1;
+            break;
+        }
+        started++;
+        result->pinned += live_pin(live.mcores[i].mthread, i, result->cpus);
+    }
+
+    /*
+     * Release the jobs as their arrival times come round, a time unit's arrivals at once.
+     */
+    for(i = 0; i < count && !live.mfailed; i = j)
+    {
+        int arrival_time = order[i]->arrival_time;
+        long long release = live.mstart + arrival_time * unit_ns;
+        struct timespec ts = { release / 1000000000LL, release % 1000000000LL };
+
+        pthread_mutex_unlock(&live.mlock);
+        while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0)
+            ;
+        pthread_mutex_lock(&live.mlock);
+
+        if(live.mfailed)
+            break;
+
+        long long now = live_now(&live);
+        for(j = i; j < count && order[j]->arrival_time == arrival_time; j++)
+        {
+            batch[j - i].job_number = order[j]->job_id;
+            batch[j - i].running_time = order[j]->run_time;
+            batch[j - i].priority = order[j]->priority;
+            order[j]->released = now;
+            live.malive++;
+        }
+
+        scheduler_new_jobs(batch, j - i, live_time(&live, now));
+
+        for(int k = 0; k < j - i; k++)
+        {
+            if(batch[k].core < -1 || batch[k].core >= cores)
+                live.mfailed = 1;
+            else if(batch[k].core != -1)
+                live_assign(&live, batch[k].core, batch[k].job_number);
+        }
+        live_check_idle(&live);
+    }
+
+    while(!live.mfailed && live.mfinished < count)
+        pthread_cond_wait(&live.mdone, &live.mlock);
+
+    live.mstop = 1;
+    for(i = 0; i < started; i++)
+        pthread_cond_signal(&live.mcores[i].mwake);
+    pthread_mutex_unlock(&live.mlock);
+
+    for(i = 0; i < started; i++)
+        pthread_join(live.mcores[i].mthread, NULL);
+
+    result->seconds = live_now(&live) / 1e9;
+    result->lost = live.mlost;
+
+    for(i = 0; i < count && !live.mfailed; i++)
+    {
+        result->waiting += (double)(jobs[i].finished - jobs[i].released - jobs[i].ran) / unit_ns;
+        result->turnaround += (double)(jobs[i].finished - jobs[i].released) / unit_ns;
+        result->response += (double)(jobs[i].first_run - jobs[i].released) / unit_ns;
+    }
+    if(count > 0)
+    {
+        result->waiting /= count;
+        result->turnaround /= count;
+        result->response /= count;
+    }
+
+    scheduler_clean_up();
+    for(i = 0; i < cores; i++)
+        pthread_cond_destroy(&live.mcores[i].mwake);
+    pthread_cond_destroy(&live.mdone);
+    pthread_mutex_destroy(&live.mlock);
+    free(live.mcores);
+    free(order);
+    free(batch);
+
+    if(started < cores)
+        return 0;
+    return live.mfailed ? -1 : 1;
+}
@@ -0,0 +1,44 @@
+/** @file liblive.h
+ */
+
+#ifndef LIBLIVE_H_
+#define LIBLIVE_H_
+
+/**
+ *  Live Job Structure, one job of a live run
+ *  Member variables:
+ *      job_id, arrival_time, run_time, priority = as read by the simulator, in time units
+ *      released = when the job was handed to the scheduler, -1 until then
+ *      first_run = when a core first started working on it, -1 until then
+ *      finished = when its last slice of work was done
+ *      ran = how long it spent on a core doing work that counted
+ *      slices = the slices of work it still has to do
+ *  The times are in ns from the start of the run, and are filled in by live_run().
+ */
+typedef struct _live_job_t
+{
+    int job_id, arrival_time, run_time, priority;
+    long long released, first_run, finished, ran;
+    int slices;
+} live_job_t;
+
+/**
+ *  Live Result Structure, what live_run() measured
+ *  Member variables:
+ *      waiting, turnaround, response = the averages over every job, in time units
+ *      seconds = the wall time of the whole run
+ *      cpus = the number of CPUs online
+ *      pinned = the number of core threads that could be pinned to a CPU
+ *      lost = the number of slices of work thrown away because the job was preempted
+ */
+typedef struct _live_result_t
+{
+    double waiting, turnaround, response;
+    double seconds;
+    int cpus, pinned;
+    long lost;
+} live_result_t;
+
+int live_run (live_job_t *jobs, int count, int cores, int scheme, int quantum, long long unit_ns, live_result_t *result);
+
+#endif /* LIBLIVE_H_ */
@@ -1,364 +1,748 @@
-/** @file libpriqueue.c
- */
-
-#include <stdlib.h>
-#include <stdio.h>
-
-#include "libpriqueue.h"
-
-
-/**
-  Initializes the priqueue_t data structure.
-  
-  Assumtions
-    - You may assume this function will only be called once per instance of priqueue_t
-    - You may assume this function will be the first function called using an instance of priqueue_t.
-  @param q a pointer to an instance of the priqueue_t data structure
-  @param comparer a function pointer that compares two elements.
-  See also @ref comparer-page
- */
-void priqueue_init(priqueue_t *q, int(*comparer)(const void *, const void *))
-{
-    //set size to zero
-    q->msize = 0;
-    //set compare function to parameter
-    q->comparer = comparer;
-    //front and back point to null
-    q->mfront = NULL;
-    q->mback = NULL;
-}
-
-
-/**
-  Inserts the specified element into this priority queue.
-
-  @param q a pointer to an instance of the priqueue_t data structure
-  @param ptr a pointer to the data to be inserted into the priority queue
-  @return The zero-based index where ptr is stored in the priority queue, where 0 indicates that ptr was stored at the front of the priority queue.
- */
-int priqueue_offer(priqueue_t *q, void *ptr)
-{
-    //if queue is empty
-    if(q->msize == 0)
-    {
-        //make a new node
-        node_t *temp = malloc(sizeof(node_t));
-        //set temp's member variables
-        temp->mvalue = ptr;
-        temp->mnext = NULL;
-        //mfront is now temp
-        q->mfront = temp;
-        //increase size
-        q->msize++;
-        //return the zero-based index, so zero since it's the first one
-        return 0;
-    } 
-    //if the queue contains at least one node we have to compare the ptr to
-    else 
-    {
-        //create a new node
-        node_t *temp = malloc(sizeof(node_t));
-        //get a pointer to the front
-        node_t *current = q->mfront;
-        //keep track of preceding node
-        node_t *prev = NULL;
-        //set temp's member variables
-        temp->mvalue = ptr;
-        temp->mnext = NULL;
-        //this is what we return
-        int index = 0;
-        
-        //this is a temp value to get the node's value as we slide through the queue
-        void *slidePtr; 
-        //slide through the queue using current
-        //in loop, set prev to current as you slide through so you know if you're at front of the list
-        while(current != NULL){
-            //if temp should come before the current node, we found where temp needs to go
-            if(q->comparer((temp->mvalue), (current->mvalue)) < 0){
-                //while the current pointer isn't null, we have to shift the remaining elements down
-                while(current != NULL){
-                    //copy value
-                    slidePtr = current->mvalue;
-                    //set the current value to new node's value
-                    current->mvalue = temp->mvalue;
-                    //set temp's value to current's old value
-                    temp->mvalue = slidePtr;
-                    //if we are at the last element in the queue, set the last element, then exit loop
-                    if(current->mnext == NULL){
-                        //the way we just copied pointer values, temp goes at the end
-                        current->mnext = temp;
-                        //break so we don't go off the queue
-                        break; 
-                    }
-                    //move current to the next element
-                    current = current->mnext;
-                }
-                //break out of the outter whileloop because we found where temp goes
-                break;
-            }
-            //increase the index we are looking at
-            index++;
-            //if we reached the end of the queue and never found where temp should go, temp goes at the end
-            if(current->mnext == NULL){
-                //set temp as the last element now
-                current->mnext = temp;
-                //break out of whileloop so we don't go off the queue
-                break;
-            }
-            //move on to next value
-            current = current->mnext;
-            
-        }
-        //increase size, return the index of where we inserted the new node
-        q->msize++;
-        return index;
-    }
-}
-
-
-/**
-  Retrieves, but does not remove, the head of this queue, returning NULL if
-  this queue is empty.
- 
-  @param q a pointer to an instance of the priqueue_t data structure
-  @return pointer to element at the head of the queue
-  @return NULL if the queue is empty
- */
-void *priqueue_peek(priqueue_t *q)
-{
-        //if the queue isn't empty, return the front (head)
-        if(q->msize != 0)
-        {
-        
-            return q->mfront;
-        }
-        //otherwise return null
-	return NULL;
-}
-
-
-/**
-  Retrieves and removes the head of this queue, or NULL if this queue
-  is empty.
- 
-  @param q a pointer to an instance of the priqueue_t data structure
-  @return the head of this queue
-  @return NULL if this queue is empty
- */
-void *priqueue_poll(priqueue_t *q)
-{
-    //if the queue has at least one element
-    if(q->msize > 0){
-        //set temp to the front
-        node_t *temp = q->mfront;
-        //if the queue is bigger than one
-        if(q->mfront->mnext != NULL){
-            //set the new front
-            q->mfront = q->mfront->mnext;
-        } else {
-            //otherwise set to null
-            q->mfront = NULL;
-        }
-        //get temp's value
-        void *tempReturn = temp->mvalue;
-        //delete
-        free(temp);
-        //decrease size
-        q->msize--;
-        //return the value
-        return  tempReturn;
-    }
-    //otherwise return null
-    return NULL;
-}
-
-
-/**
-  Returns the element at the specified position in this list, or NULL if
-  the queue does not contain an index'th element.
- 
-  @param q a pointer to an instance of the priqueue_t data structure
-  @param index position of retrieved element
-  @return the index'th element in the queue
-  @return NULL if the queue does not contain the index'th element
- */
-void *priqueue_at(priqueue_t *q, int index)
-{
-        //if the index is greater than zero, attempt to find the value at the given index
-        if (index >= 0){
-            //current index
-            int i = 0;
-            //set temp to the front
-            node_t *temp = q->mfront;
-            //while we haven't gone off the list
-            while(temp != NULL){
-                //if current index is the desired index
-                if( i == index){
-                    //return temp's value
-                    return temp->mvalue;
-                }
-                //go to the next element at the next index
-                temp = temp->mnext;
-                i++;
-            }
-            
-            
-        }
-        //if index was not in the range of the queue, return null
-	return NULL;
-}
-
-
-/**
-  Removes all instances of ptr from the queue. 
-  
-  This function should not use the comparer function, but check if the data contained in each element of the queue is equal (==) to ptr.
- 
-  @param q a pointer to an instance of the priqueue_t data structure
-  @param ptr address of element to be removed
-  @return the number of entries removed
- */
-int priqueue_remove(priqueue_t *q, void *ptr)
-{
-    //if queue is empty
-    if(q->msize == 0){
-	return 0;
-    } else {
-        //the count of entries removed after we're done
-        int count = 0;
-        //set our temporary variables
-        node_t *current = q->mfront;
-        node_t *prev = q->mfront;
-        //if the node containing ptr is at the front and 0 or more matching follow, take care of all matching pointers at the front so front points to the correct element
-        while(current != NULL && current->mvalue == ptr){
-            //get next
-            q->mfront = current->mnext;
-            //delete
-            free(current);
-            //move current to the next element
-            current = q->mfront;
-            //decrease size and increase count of nodes removed
-            q->msize--;
-            count++;
-        }
-        //all others in the list
-        while(current != NULL){
-            //continue while the value is not equal to the pointer
-            while(current!=NULL && current->mvalue != ptr){
-                //update prev and current
-                prev = current;
-                current = current->mnext;
-            }
-            //if we've reached the end of the list, return with the count
-            if(current == NULL){
-            
-                return count;
-            }
-            //found a matching element
-            //connect the previous with current's next to bridge the gap
-            prev->mnext = current->mnext;
-            //delete current
-            free(current);
-            //set current to the next element
-            current = prev->mnext;
-            //increase count, decrease size
-            count++;
-            q->msize--;
-        }
-        //all done, return count
-        return count;
-    }
-}
-
-/**
-  Removes the specified index from the queue, moving later elements up
-  a spot in the queue to fill the gap.
- 
-  @param q a pointer to an instance of the priqueue_t data structure
-  @param index position of element to be removed
-  @return the element removed from the queue
-  @return NULL if the specified index does not exist
- */
-void *priqueue_remove_at(priqueue_t *q, int index)
-{
-        //set up temporary nodes
-        node_t *current;
-        node_t *next;
-        node_t *prev;
-        //if queue isn't empty
-        if(q->msize > 0){
-            //check if the element at the index at the queue isn't null
-            if(priqueue_at(q, index) != NULL){
-                //if not, set temp equal to the value
-                node_t *temp = priqueue_at(q, index);
-                //set the value to return at temp
-                void *tempReturn = temp->mvalue;
-                //if there's one element in the queue
-                if(temp == q->mfront && temp == q->mback){
-                
-                    q->mfront == NULL;
-                    q->mback == NULL;
-                    //if temp is the front
-                } else if (temp == q->mfront){
-                    //set front to the next element
-                    q->mfront = temp->mnext;
-                } else if (temp == q->mback){
-                    //set new back
-                    q->mback= priqueue_at(q, index - 1);
-                    q->mback->mnext = NULL; //check if neccessary 
-                } else { //if element is somewhere else in the list
-                    //set previous to the element at the previous index
-                    prev = priqueue_at(q, index - 1);
-                    //set next to the element at the next index
-                    next = priqueue_at(q, index + 1);
-                    //connect the two
-                    prev->mnext = next;
-                }
-                //delete temp, decrease size, return temp's value
-                free(temp);
-                q->msize --; 
-                return tempReturn;
-                
-            }
-        }
-	return NULL;
-}
-
-
-/**
-  Returns the number of elements in the queue.
- 
-  @param q a pointer to an instance of the priqueue_t data structure
-  @return the number of elements in the queue
- */
-int priqueue_size(priqueue_t *q)
-{
-	return q->msize;
-}
-
-
-/**
-  Destroys and frees all the memory associated with q.
-  
-  @param q a pointer to an instance of the priqueue_t data structure
- */
-void priqueue_destroy(priqueue_t *q)
-{
-    //if there are elements to destroy 
-    if (q->msize > 0){
-        //set temp to front, get a next value
-        node_t *temp = q->mfront;
-        node_t *next = temp;
-        //while there are still elements
-        while(temp != NULL){
-            //set next to temp's next
-            next = temp->mnext;
-            //delete temp
-            free(temp);
-            //set temp to the next element
-            temp = next;
-            //decrease size
-            q->msize--;
-        }
-    }
-}
+/** @file libpriqueue.c
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "libpriqueue.h"
+
+/*
+  Comparisons are only counted when built with PRIQUEUE_STATS (make STATS=1).
+  PRIQUEUE_COUNT() always evaluates to true so it can sit inside a loop condition.
+*/
+#ifdef PRIQUEUE_STATS
+#define PRIQUEUE_COUNT(q) (++(q)->mcomparisons)
+#else
+#define PRIQUEUE_COUNT(q) (1)
+#endif
+
+/*
+  An element of a batch, with its key for keyed queues. Also a slot of a ring queue.
+*/
+typedef struct _entry_t
+{
+    void *mvalue;
+    long long mkey;
+} entry_t;
+
+/*
+  The slot of a ring queue holding its index'th element
+*/
+static entry_t *priqueue_ring_at(priqueue_t *q, int index)
+{
+    return &q->mring[(q->mhead + index) & (q->mcap - 1)];
+}
+
+/*
+  Inserts into a ring queue. An element whose key is no smaller than the back's
+  is appended in O(1); any other is placed after the last element with a key no
+  larger than its own, moving the elements behind it back a slot.
+*/
+static int priqueue_ring_offer(priqueue_t *q, void *ptr, long long key)
+{
+    if(q->msize == q->mcap)
+    {
+        //double the ring, unwrapping it so the front is in slot 0
+        entry_t *ring = malloc(2 * q->mcap * sizeof(entry_t));
+        for(int i = 0; i < q->msize; i++)
+            ring[i] = *priqueue_ring_at(q, i);
+        free(q->mring);
+        q->mring = ring;
+        q->mhead = 0;
+        q->mcap *= 2;
+    }
+
+    int index = q->msize;
+    while(index > 0 && PRIQUEUE_COUNT(q) && priqueue_ring_at(q, index - 1)->mkey > key)
+    {
+        *priqueue_ring_at(q, index) = *priqueue_ring_at(q, index - 1);
+        index--;
+    }
+    priqueue_ring_at(q, index)->mvalue = ptr;
+    priqueue_ring_at(q, index)->mkey = key;
+    q->msize++;
+    return index;
+}
+
+/*
+  Takes the index'th element out of a ring queue, moving the elements behind it
+  forward a slot
+*/
+static void *priqueue_ring_remove_at(priqueue_t *q, int index)
+{
+    void *ptr = priqueue_ring_at(q, index)->mvalue;
+
+    if(index == 0)
+    {
+        q->mhead = (q->mhead + 1) & (q->mcap - 1);
+    }
+    else
+    {
+        for(int i = index; i < q->msize - 1; i++)
+            *priqueue_ring_at(q, i) = *priqueue_ring_at(q, i + 1);
+    }
+    q->msize--;
+    return ptr;
+}
+
+/*
+  The node holding an element about to be inserted: its embedded node in an
+  intrusive queue, a newly allocated one otherwise
+*/
+static node_t *priqueue_node(priqueue_t *q, void *ptr)
+{
+    if(q->moffset >= 0)
+        return (node_t *)((char *)ptr + q->moffset);
+    return malloc(sizeof(node_t));
+}
+
+/*
+  Lets go of the node of an element that has left the queue
+*/
+static void priqueue_node_free(priqueue_t *q, node_t *node)
+{
+    if(q->moffset < 0)
+        free(node);
+}
+
+
+/**
+  Initializes the priqueue_t data structure.
+  
+  Assumtions
+    - You may assume this function will only be called once per instance of priqueue_t
+    - You may assume this function will be the first function called using an instance of priqueue_t.
+  @param q a pointer to an instance of the priqueue_t data structure
+  @param comparer a function pointer that compares two elements, or NULL for a
+  keyed queue (see priqueue_init_keyed()).
+  See also @ref comparer-page
+ */
+void priqueue_init(priqueue_t *q, int(*comparer)(const void *, const void *))
+{
+    //set size to zero
+    q->msize = 0;
+    //set compare function to parameter
+    q->comparer = comparer;
+    //front and back point to null
+    q->mfront = NULL;
+    q->mback = NULL;
+    q->mcomparisons = 0;
+    q->moffset = -1;
+    q->mring = NULL;
+    q->mhead = 0;
+    q->mcap = 0;
+}
+
+
+/**
+  Inserts the specified element into this priority queue.
+
+  @param q a pointer to an instance of the priqueue_t data structure
+  @param ptr a pointer to the data to be inserted into the priority queue
+  @return The zero-based index where ptr is stored in the priority queue, where 0 indicates that ptr was stored at the front of the priority queue.
+ */
+int priqueue_offer(priqueue_t *q, void *ptr)
+{
+    //if queue is empty
+    if(q->msize == 0)
+    {
+        //make a new node
+        node_t *temp = priqueue_node(q, ptr);
+        //set temp's member variables
+        temp->mvalue = ptr;
+        temp->mnext = NULL;
+        temp->mkey = 0;
+        //mfront is now temp
+        q->mfront = temp;
+        //increase size
+        q->msize++;
+        //return the zero-based index, so zero since it's the first one
+        return 0;
+    } 
+    //if the queue contains at least one node we have to compare the ptr to
+    else 
+    {
+        //create a new node
+        node_t *temp = priqueue_node(q, ptr);
+        //set temp's member variables
+        temp->mvalue = ptr;
+        temp->mkey = 0;
+        //this is what we return
+        int index = 0;
+        
+        //slide through the queue to the first node temp should come before, or the end;
+        //temp is linked in right there, so every other node keeps its element
+        node_t **link = &q->mfront;
+        while(*link != NULL && !(PRIQUEUE_COUNT(q) && q->comparer(ptr, (*link)->mvalue) < 0)){
+            //move on to next node, and increase the index we are looking at
+            link = &(*link)->mnext;
+            index++;
+        }
+        temp->mnext = *link;
+        *link = temp;
+        //increase size, return the index of where we inserted the new node
+        q->msize++;
+        return index;
+    }
+}
+
+
+/**
+  Initializes a keyed priqueue_t data structure.
+
+  Instead of calling a comparer, a keyed queue orders its elements by a 64-bit
+  integer key given with each element (smallest key first, equal keys in the
+  order they were offered). The key is stored inline in the node, so walking
+  the queue is a plain integer compare with no calls and no dereferencing of
+  the elements. Elements must be inserted with priqueue_offer_keyed() or
+  priqueue_offer_all_keyed(); every other function works as usual.
+
+  @param q a pointer to an instance of the priqueue_t data structure
+ */
+void priqueue_init_keyed(priqueue_t *q)
+{
+    priqueue_init(q, NULL);
+}
+
+
+/**
+  Initializes an intrusive priqueue_t data structure.
+
+  Every element of an intrusive queue has a node_t embedded in it, at the same
+  offset, which the queue links in place of allocating a node of its own. Offering
+  and polling then allocate nothing, and the key of a keyed queue sits next to the
+  rest of the element. An element can only be in one intrusive queue at a time,
+  and only once; its node is left alone when it leaves the queue.
+
+  @param q a pointer to an instance of the priqueue_t data structure
+  @param comparer a function pointer that compares two elements, or NULL for a
+  keyed queue (see priqueue_init_keyed())
+  @param node_offset where the node sits in each element, offsetof() of it
+ */
+void priqueue_init_intrusive(priqueue_t *q, int(*comparer)(const void *, const void *), size_t node_offset)
+{
+    priqueue_init(q, comparer);
+    q->moffset = (long)node_offset;
+}
+
+
+/**
+  Initializes a keyed priqueue_t data structure that keeps its elements in a
+  growable ring buffer instead of a linked list.
+
+  A ring queue is meant for elements that mostly arrive in key order, as in a
+  FIFO. An element whose key is no smaller than the back's is appended in O(1),
+  and polling is O(1), with no allocation per element. An element that belongs
+  further forward is still put in its place, at the cost of moving the elements
+  behind it. Elements must be inserted with priqueue_offer_keyed() or
+  priqueue_offer_all_keyed(); every other function works as usual.
+
+  @param q a pointer to an instance of the priqueue_t data structure
+ */
+void priqueue_init_ring(priqueue_t *q)
+{
+    priqueue_init(q, NULL);
+    q->mcap = 16;
+    q->mring = malloc(q->mcap * sizeof(entry_t));
+}
+
+
+/**
+  Inserts the specified element into a keyed priority queue.
+
+  @param q a pointer to an instance of a keyed priqueue_t data structure
+  @param ptr a pointer to the data to be inserted into the priority queue
+  @param key the sort key of ptr
+  @return The zero-based index where ptr is stored in the priority queue, where 0 indicates that ptr was stored at the front of the priority queue.
+ */
+int priqueue_offer_keyed(priqueue_t *q, void *ptr, long long key)
+{
+    if(q->mring != NULL)
+        return priqueue_ring_offer(q, ptr, key);
+
+    node_t *temp = priqueue_node(q, ptr);
+    temp->mvalue = ptr;
+    temp->mkey = key;
+
+    //find the first node with a larger key, the new node goes right before it
+    node_t **link = &q->mfront;
+    int index = 0;
+    while(*link != NULL && PRIQUEUE_COUNT(q) && (*link)->mkey <= key)
+    {
+        link = &(*link)->mnext;
+        index++;
+    }
+    temp->mnext = *link;
+    *link = temp;
+    q->msize++;
+    return index;
+}
+
+
+/*
+  Whether element a (with key akey) belongs strictly before element b
+*/
+static int priqueue_before(priqueue_t *q, void *a, long long akey, void *b, long long bkey)
+{
+    PRIQUEUE_COUNT(q);
+    if(q->comparer == NULL)
+        return akey < bkey;
+    return q->comparer(a, b) < 0;
+}
+
+/*
+  Stably sorts a batch and merges it into the queue in a single pass
+*/
+static void priqueue_merge(priqueue_t *q, entry_t *batch, int count)
+{
+    //bottom-up merge sort; only take from the right run if it strictly belongs first, which keeps it stable
+    entry_t *buffer = malloc(count * sizeof(entry_t));
+    entry_t *from = batch;
+    entry_t *to = buffer;
+    for(int width = 1; width < count; width *= 2)
+    {
+        for(int lo = 0; lo < count; lo += 2 * width)
+        {
+            int mid = lo + width < count ? lo + width : count;
+            int hi = lo + 2 * width < count ? lo + 2 * width : count;
+            int left = lo, right = mid, out = lo;
+            while(left < mid && right < hi)
+            {
+                if(priqueue_before(q, from[right].mvalue, from[right].mkey, from[left].mvalue, from[left].mkey))
+                    to[out++] = from[right++];
+                else
+                    to[out++] = from[left++];
+            }
+            while(left < mid)
+                to[out++] = from[left++];
+            while(right < hi)
+                to[out++] = from[right++];
+        }
+        entry_t *swap = from;
+        from = to;
+        to = swap;
+    }
+    //the sorted run may have ended up in the buffer
+    if(from != batch)
+        memcpy(batch, from, count * sizeof(entry_t));
+    free(buffer);
+
+    if(q->mring != NULL)
+    {
+        for(int i = 0; i < count; i++)
+            priqueue_ring_offer(q, batch[i].mvalue, batch[i].mkey);
+        return;
+    }
+
+    //merge the sorted batch into the list; like priqueue_offer, a new element goes after its equals
+    node_t *prev = NULL;
+    node_t *current = q->mfront;
+    for(int i = 0; i < count; i++)
+    {
+        while(current != NULL && !priqueue_before(q, batch[i].mvalue, batch[i].mkey, current->mvalue, current->mkey))
+        {
+            prev = current;
+            current = current->mnext;
+        }
+        node_t *temp = priqueue_node(q, batch[i].mvalue);
+        temp->mvalue = batch[i].mvalue;
+        temp->mkey = batch[i].mkey;
+        temp->mnext = current;
+        if(prev == NULL)
+            q->mfront = temp;
+        else
+            prev->mnext = temp;
+        prev = temp;
+        q->msize++;
+    }
+}
+
+
+/**
+  Inserts several elements at once.
+
+  The result is the same as offering ptrs[0], ptrs[1], ... one after the other,
+  including the order of elements the comparer considers equal, but it costs one
+  O(count log count) sort of the batch and a single O(size + count) pass over the
+  queue instead of count passes.
+
+  @param q a pointer to an instance of the priqueue_t data structure
+  @param ptrs the elements to be inserted. The array is reordered (stably sorted) in place.
+  @param count the number of elements in ptrs
+  @return the number of elements inserted
+ */
+int priqueue_offer_all(priqueue_t *q, void **ptrs, int count)
+{
+    if(count <= 0)
+        return 0;
+
+    entry_t *batch = malloc(count * sizeof(entry_t));
+    for(int i = 0; i < count; i++)
+    {
+        batch[i].mvalue = ptrs[i];
+        batch[i].mkey = 0;
+    }
+    priqueue_merge(q, batch, count);
+    for(int i = 0; i < count; i++)
+        ptrs[i] = batch[i].mvalue;
+    free(batch);
+    return count;
+}
+
+
+/**
+  Inserts several elements at once into a keyed priority queue, see priqueue_offer_all().
+
+  @param q a pointer to an instance of a keyed priqueue_t data structure
+  @param ptrs the elements to be inserted. The array is reordered (stably sorted by key) in place.
+  @param keys the sort key of each element of ptrs, reordered along with ptrs
+  @param count the number of elements in ptrs
+  @return the number of elements inserted
+ */
+int priqueue_offer_all_keyed(priqueue_t *q, void **ptrs, long long *keys, int count)
+{
+    if(count <= 0)
+        return 0;
+
+    entry_t *batch = malloc(count * sizeof(entry_t));
+    for(int i = 0; i < count; i++)
+    {
+        batch[i].mvalue = ptrs[i];
+        batch[i].mkey = keys[i];
+    }
+    priqueue_merge(q, batch, count);
+    for(int i = 0; i < count; i++)
+    {
+        ptrs[i] = batch[i].mvalue;
+        keys[i] = batch[i].mkey;
+    }
+    free(batch);
+    return count;
+}
+
+
+/**
+  Retrieves, but does not remove, the head of this queue, returning NULL if
+  this queue is empty.
+ 
+  @param q a pointer to an instance of the priqueue_t data structure
+  @return pointer to element at the head of the queue
+  @return NULL if the queue is empty
+ */
+void *priqueue_peek(priqueue_t *q)
+{
+        //if the queue isn't empty, return the front (head)
+        if(q->msize != 0)
+        {
+            if(q->mring != NULL)
+                return priqueue_ring_at(q, 0)->mvalue;
+            return q->mfront->mvalue;
+        }
+        //otherwise return null
+	return NULL;
+}
+
+
+/**
+  Retrieves, but does not remove, the key of the head of a keyed queue.
+
+  @param q a pointer to an instance of a keyed priqueue_t data structure
+  @param key set to the key of the head
+  @return 1 if the queue has a head
+  @return 0 if the queue is empty, key is left alone
+ */
+int priqueue_peek_key(priqueue_t *q, long long *key)
+{
+    if(q->msize == 0)
+        return 0;
+    *key = q->mring != NULL ? priqueue_ring_at(q, 0)->mkey : q->mfront->mkey;
+    return 1;
+}
+
+
+/**
+  Retrieves and removes the head of this queue, or NULL if this queue
+  is empty.
+ 
+  @param q a pointer to an instance of the priqueue_t data structure
+  @return the head of this queue
+  @return NULL if this queue is empty
+ */
+void *priqueue_poll(priqueue_t *q)
+{
+    if(q->mring != NULL)
+        return q->msize > 0 ? priqueue_ring_remove_at(q, 0) : NULL;
+
+    //if the queue has at least one element
+    if(q->msize > 0){
+        //set temp to the front
+        node_t *temp = q->mfront;
+        //if the queue is bigger than one
+        if(q->mfront->mnext != NULL){
+            //set the new front
+            q->mfront = q->mfront->mnext;
+        } else {
+            //otherwise set to null
+            q->mfront = NULL;
+        }
+        //get temp's value
+        void *tempReturn = temp->mvalue;
+        //delete
+        priqueue_node_free(q, temp);
+        //decrease size
+        q->msize--;
+        //return the value
+        return  tempReturn;
+    }
+    //otherwise return null
+    return NULL;
+}
+
+
+/**
+  Returns the element at the specified position in this list, or NULL if
+  the queue does not contain an index'th element.
+ 
+  @param q a pointer to an instance of the priqueue_t data structure
+  @param index position of retrieved element
+  @return the index'th element in the queue
+  @return NULL if the queue does not contain the index'th element
+ */
+void *priqueue_at(priqueue_t *q, int index)
+{
+        if(q->mring != NULL)
+            return index >= 0 && index < q->msize ? priqueue_ring_at(q, index)->mvalue : NULL;
+
+        //if the index is greater than zero, attempt to find the value at the given index
+        if (index >= 0){
+            //current index
+            int i = 0;
+            //set temp to the front
+            node_t *temp = q->mfront;
+            //while we haven't gone off the list
+            while(temp != NULL){
+                //if current index is the desired index
+                if( i == index){
+                    //return temp's value
+                    return temp->mvalue;
+                }
+                //go to the next element at the next index
+                temp = temp->mnext;
+                i++;
+            }
+            
+            
+        }
+        //if index was not in the range of the queue, return null
+	return NULL;
+}
+
+
+/**
+  Removes all instances of ptr from the queue. 
+  
+  This function should not use the comparer function, but check if the data contained in each element of the queue is equal (==) to ptr.
+ 
+  @param q a pointer to an instance of the priqueue_t data structure
+  @param ptr address of element to be removed
+  @return the number of entries removed
+ */
+int priqueue_remove(priqueue_t *q, void *ptr)
+{
+    if(q->mring != NULL)
+    {
+        //keep the elements that stay, in order, closing up the gaps
+        int kept = 0;
+        for(int i = 0; i < q->msize; i++)
+            if(priqueue_ring_at(q, i)->mvalue != ptr)
+                *priqueue_ring_at(q, kept++) = *priqueue_ring_at(q, i);
+        int count = q->msize - kept;
+        q->msize = kept;
+        return count;
+    }
+
+    //if queue is empty
+    if(q->msize == 0){
+	return 0;
+    } else {
+        //the count of entries removed after we're done
+        int count = 0;
+        //set our temporary variables
+        node_t *current = q->mfront;
+        node_t *prev = q->mfront;
+        //if the node containing ptr is at the front and 0 or more matching follow, take care of all matching pointers at the front so front points to the correct element
+        while(current != NULL && current->mvalue == ptr){
+            //get next
+            q->mfront = current->mnext;
+            //delete
+            priqueue_node_free(q, current);
+            //move current to the next element
+            current = q->mfront;
+            //decrease size and increase count of nodes removed
+            q->msize--;
+            count++;
+        }
+        //all others in the list
+        while(current != NULL){
+            //continue while the value is not equal to the pointer
+            while(current!=NULL && current->mvalue != ptr){
+                //update prev and current
+                prev = current;
+                current = current->mnext;
+            }
+            //if we've reached the end of the list, return with the count
+            if(current == NULL){
+            
+                return count;
+            }
+            //found a matching element
+            //connect the previous with current's next to bridge the gap
+            prev->mnext = current->mnext;
+            //delete current
+            priqueue_node_free(q, current);
+            //set current to the next element
+            current = prev->mnext;
+            //increase count, decrease size
+            count++;
+            q->msize--;
+        }
+        //all done, return count
+        return count;
+    }
+}
+
+/**
+  Removes the specified index from the queue, moving later elements up
+  a spot in the queue to fill the gap.
+ 
+  @param q a pointer to an instance of the priqueue_t data structure
+  @param index position of element to be removed
+  @return the element removed from the queue
+  @return NULL if the specified index does not exist
+ */
+void *priqueue_remove_at(priqueue_t *q, int index)
+{
+    if(index < 0 || index >= q->msize)
+        return NULL;
+    if(q->mring != NULL)
+        return priqueue_ring_remove_at(q, index);
+
+    //walk to the link pointing at the index'th node and bridge over it
+    node_t **link = &q->mfront;
+    for(int i = 0; i < index; i++)
+        link = &(*link)->mnext;
+
+    node_t *temp = *link;
+    void *tempReturn = temp->mvalue;
+    *link = temp->mnext;
+    priqueue_node_free(q, temp);
+    q->msize--;
+    return tempReturn;
+}
+
+
+/**
+  Returns the number of elements in the queue.
+ 
+  @param q a pointer to an instance of the priqueue_t data structure
+  @return the number of elements in the queue
+ */
+int priqueue_size(priqueue_t *q)
+{
+	return q->msize;
+}
+
+
+/**
+  Starts walking the queue from the front. Each call to priqueue_iter_next() then
+  takes one step, so visiting every element is O(n), unlike calling priqueue_at()
+  for each index.
+  The queue must not be changed while it is being walked.
+
+  @param q a pointer to an instance of the priqueue_t data structure
+  @param it the iterator to set up
+ */
+void priqueue_iter_begin(priqueue_t *q, priqueue_iter_t *it)
+{
+    it->mqueue = q;
+    it->mnode = q->mfront;
+    it->mindex = 0;
+}
+
+
+/**
+  Returns the next element of the queue, front to back.
+
+  @param it an iterator set up by priqueue_iter_begin()
+  @return the next element
+  @return NULL if every element has been visited
+ */
+void *priqueue_iter_next(priqueue_iter_t *it)
+{
+    if(it->mqueue->mring != NULL)
+        return it->mindex < it->mqueue->msize ? priqueue_ring_at(it->mqueue, it->mindex++)->mvalue : NULL;
+
+    if(it->mnode == NULL)
+        return NULL;
+
+    void *ptr = it->mnode->mvalue;
+    it->mnode = it->mnode->mnext;
+    return ptr;
+}
+
+
+/**
+  Copies the elements of the queue, front to back, into an array.
+
+  @param q a pointer to an instance of the priqueue_t data structure
+  @param array where to copy the elements
+  @param max the size of array
+  @return the number of elements copied, at most max
+ */
+int priqueue_to_array(priqueue_t *q, void **array, int max)
+{
+    priqueue_iter_t it;
+    int count = 0;
+
+    priqueue_iter_begin(q, &it);
+    while(count < max && count < q->msize)
+        array[count++] = priqueue_iter_next(&it);
+
+    return count;
+}
+
+
+/**
+  Destroys and frees all the memory associated with q.
+  
+  @param q a pointer to an instance of the priqueue_t data structure
+ */
+void priqueue_destroy(priqueue_t *q)
+{
+    if(q->mring != NULL)
+    {
+        free(q->mring);
+        q->mring = NULL;
+        q->msize = 0;
+        return;
+    }
+
+    //if there are elements to destroy 
+    if (q->msize > 0){
+        //set temp to front, get a next value
+        node_t *temp = q->mfront;
+        node_t *next = temp;
+        //while there are still elements
+        while(temp != NULL){
+            //set next to temp's next
+            next = temp->mnext;
+            //delete temp
+            priqueue_node_free(q, temp);
+            //set temp to the next element
+            temp = next;
+            //decrease size
+            q->msize--;
+        }
+    }
+}
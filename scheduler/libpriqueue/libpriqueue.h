@@ -1,52 +1,92 @@
-/** @file libpriqueue.h
- */
-
-#ifndef LIBPRIQUEUE_H_
-#define LIBPRIQUEUE_H_
-
-
-/**
- *  Node Structure
- *  Member variables:
- *      mvalue = the void * value stored in the node
- *      mnext = the node pointer to the next node in the queue
- */
-typedef struct node_t node_t;
-struct node_t
-{
-    void *mvalue;
-    node_t *mnext;
-    
-};
-
-/**
-*  Priqueue Data Structure
-*  Member variables:
-*       msize = the size of the priority queue
-*       comparer = the compare function used to determine the order of the nodes in the queue
-*       mfront = a node pointer to the front of the queue
-*       mback = a node pointer to the back of the queue
-*/
-typedef struct _priqueue_t
-{
-    int msize; //we can use size_t later if neccessary
-    int(*comparer)(const void *, const void *);
-    node_t *mfront;
-    node_t *mback; //make sure this is neccessary
-    
-} priqueue_t;
-
-
-void   priqueue_init     (priqueue_t *q, int(*comparer)(const void *, const void *));
-
-int    priqueue_offer    (priqueue_t *q, void *ptr);
-void * priqueue_peek     (priqueue_t *q);
-void * priqueue_poll     (priqueue_t *q);
-void * priqueue_at       (priqueue_t *q, int index);
-int    priqueue_remove   (priqueue_t *q, void *ptr);
-void * priqueue_remove_at(priqueue_t *q, int index);
-int    priqueue_size     (priqueue_t *q);
-
-void   priqueue_destroy  (priqueue_t *q);
-
-#endif /* LIBPQUEUE_H_ */
+/** @file libpriqueue.h
+ */
+
+#ifndef LIBPRIQUEUE_H_
+#define LIBPRIQUEUE_H_
+
+#include <stddef.h>
+
+/**
+ *  Node Structure. An intrusive queue (see priqueue_init_intrusive()) uses a
+ *  node embedded in each element instead of allocating one.
+ *  Member variables:
+ *      mvalue = the void * value stored in the node
+ *      mnext = the node pointer to the next node in the queue
+ *      mkey = the sort key of the node (keyed queues only)
+ */
+typedef struct node_t node_t;
+struct node_t
+{
+    void *mvalue;
+    node_t *mnext;
+    long long mkey;
+
+};
+
+/**
+*  Priqueue Data Structure
+*  Member variables:
+*       msize = the size of the priority queue
+*       comparer = the compare function used to determine the order of the nodes in the queue, NULL if the queue is keyed
+*       mfront = a node pointer to the front of the queue
+*       mback = a node pointer to the back of the queue
+*       mcomparisons = the number of comparisons made (only counted when built with PRIQUEUE_STATS)
+*       moffset = the offset of the node embedded in each element, -1 if nodes are allocated
+*       mring = the elements of a ring queue with their keys, NULL for a linked queue (see priqueue_init_ring())
+*       mhead = the slot of mring holding the front of the queue
+*       mcap = the number of slots in mring, a power of two
+*/
+typedef struct _priqueue_t
+{
+    int msize; //we can use size_t later if neccessary
+    int(*comparer)(const void *, const void *);
+    node_t *mfront;
+    node_t *mback; //make sure this is neccessary
+    long mcomparisons;
+    long moffset;
+    struct _entry_t *mring;
+    int mhead;
+    int mcap;
+
+} priqueue_t;
+
+/**
+*  Priqueue Iterator, see priqueue_iter_begin()
+*  Member variables:
+*       mqueue = the queue being walked
+*       mnode = the node holding the next element to hand out, NULL at the end
+*       mindex = the position of the next element to hand out (ring queues only)
+*/
+typedef struct _priqueue_iter_t
+{
+    priqueue_t *mqueue;
+    node_t *mnode;
+    int mindex;
+
+} priqueue_iter_t;
+
+
+void   priqueue_init     (priqueue_t *q, int(*comparer)(const void *, const void *));
+void   priqueue_init_keyed(priqueue_t *q);
+void   priqueue_init_intrusive(priqueue_t *q, int(*comparer)(const void *, const void *), size_t node_offset);
+void   priqueue_init_ring(priqueue_t *q);
+
+int    priqueue_offer    (priqueue_t *q, void *ptr);
+int    priqueue_offer_all(priqueue_t *q, void **ptrs, int count);
+int    priqueue_offer_keyed    (priqueue_t *q, void *ptr, long long key);
+int    priqueue_offer_all_keyed(priqueue_t *q, void **ptrs, long long *keys, int count);
+void * priqueue_peek     (priqueue_t *q);
+int    priqueue_peek_key (priqueue_t *q, long long *key);
+void * priqueue_poll     (priqueue_t *q);
+void * priqueue_at       (priqueue_t *q, int index);
+int    priqueue_remove   (priqueue_t *q, void *ptr);
+void * priqueue_remove_at(priqueue_t *q, int index);
+int    priqueue_size     (priqueue_t *q);
+
+void   priqueue_iter_begin(priqueue_t *q, priqueue_iter_t *it);
+void * priqueue_iter_next (priqueue_iter_t *it);
+int    priqueue_to_array (priqueue_t *q, void **array, int max);
+
+void   priqueue_destroy  (priqueue_t *q);
+
+#endif /* LIBPQUEUE_H_ */
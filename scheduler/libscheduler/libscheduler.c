@@ -1,645 +1,2143 @@
-/** @file libscheduler.c
- */
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-
-#include "libscheduler.h"
-#include "../libpriqueue/libpriqueue.h"
-
-priqueue_t q;
-
-//function pointers
-int (* Comparer_ptr) (const void *, const void *) = NULL;
-
-/**
-  Stores information making up a job to be scheduled including any statistics.
-  You may need to define some global variables or a struct to store your job queue elements.
-*/
-typedef struct _job_t
-{
-    int pid; //pid passed in
-    int arrivalTime; //arrival time passed in
-    int priority; //priority passed in
-    int runningTime; //running time passed in
-    int timeRemaining; //runningTime - time it has been executed
-    int core; // zero indexed core on which the job is running, -1 if idle
-    int lastScheduled; //when the job was last scheduled to run
-    int waitTime;
-    int responseTime;
-    int turnAroundTime;
-
-} job_t;
-
-/*
-  array for cores, stores bools of whether a job is running on the core of that
-  index or not
-*/
-job_t* *coreArr;
-
-//number of cores we're using
-int numCores = 0;
-
-scheme_t schedScheme;
-
-float totalWaitingTime; //total waiting time
-float totalResponseTime; //total response time
-float totalTATime; //total turnaround time
-int numOfJobs; //number of jobs for the scheduler
-
-/**
- * FCFS
- * First come first serve compare function
- */
-int FCFScomparer(const void *a, const void *b){
-   job_t *jobA = (job_t *)a;
-   job_t *jobB = (job_t *)b;
-   //we want ascending order for arrival time, so put a before b
-   return (jobA->arrivalTime - jobB->arrivalTime);
-}
-/**
- * SJF
- * Shortest job first compare function
- */
-int SJFcomparer(const void *a, const void *b){
-   job_t *jobA = (job_t *)a;
-   job_t *jobB = (job_t *)b;
-   //we want ascending order for running time, so put a before b
-   return (jobA->runningTime - jobB->runningTime);
-}
-/**
- * PSJF
- * Preemptive shortest job first compare function
- * Schedule based on its remaining time, not full running time
- */
-int PSJFcomparer(const void *a, const void *b){
-   job_t *jobA = (job_t *)a;
-   job_t *jobB = (job_t *)b;
-   //if running time of A is less than the remaining time of B, schedule it before
-   return (jobA->timeRemaining - jobB->timeRemaining);
-}
-/**
- * PRI
- * Priority compare function
- */
-int PRIcomparer(const void *a, const void *b){
-   job_t *jobA = (job_t *)a;
-   job_t *jobB = (job_t *)b;
-   //if the priorities are not the same
-   if(jobA->priority != jobB->priority){
-       //we want descending priority
-       return (jobA->priority - jobB->priority);
-   }
-   //if the priorities are the same, go off of arrival time
-   return (jobA->arrivalTime - jobB->arrivalTime);
-}
-/**
- * PPRI
- * Preemptive priority compare function
- */
-int PPRIcomparer(const void *a, const void *b){
-   job_t *jobA = (job_t *)a;
-   job_t *jobB = (job_t *)b;
-   //if the priorities are not the same
-   if(jobA->priority != jobB->priority){
-       //we want descending priority
-       return (jobA->priority - jobB->priority);
-   }
-   //if the priorities are the same, go off of job time
-   return (jobA->arrivalTime - jobB->arrivalTime);
-}
-/**
- * RR
- * Round Robin compare function
- *
- * needed? it's just FCFS
- */
-int RRcomparer(const void *a, const void *b){
-   //We want the job to go to the back of the queue, so don't judge off of any criteria
-   return (1);
-}
-
-/**
-  Initalizes the scheduler.
-  Assumptions:
-    - You may assume this will be the first scheduler function called.
-    - You may assume this function will be called once once.
-    - You may assume that cores is a positive, non-zero number.
-    - You may assume that scheme is a valid scheduling scheme.
-  @param cores the number of cores that is available by the scheduler. These cores will be known as core(id=0), core(id=1), ..., core(id=cores-1).
-  @param scheme  the scheduling scheme that should be used. This value will be one of the six enum values of scheme_t (from the header)
-*/
-void scheduler_start_up(int cores, scheme_t scheme)
-{
-    totalWaitingTime = 0.0; //total waiting time
-    totalResponseTime = 0.0; //total response time
-    totalTATime = 0.0; //total turnaround time
-    numOfJobs = 0;
-    //set the Comparer_ptr to proper function
-    switch(scheme)
-    {
-      case FCFS :
-        Comparer_ptr = FCFScomparer;
-        break;
-
-      case SJF :
-        Comparer_ptr = SJFcomparer;
-        break;
-
-      case PSJF :
-        Comparer_ptr = PSJFcomparer;
-        break;
-
-      case PRI :
-        Comparer_ptr = PRIcomparer;
-        break;
-
-      case PPRI :
-        Comparer_ptr = PPRIcomparer;
-        break;
-
-      case RR :
-        Comparer_ptr = RRcomparer;
-        break;
-    }
-
-    //initialze priorityqueue with
-    priqueue_init(&q, Comparer_ptr);
-
-    /*
-      setup and initialize cores to false
-    */
-    coreArr = malloc(cores*sizeof(job_t));
-
-    //set the global variable for cleanup later
-    numCores = cores;
-
-    schedScheme = scheme;
-    //initialize the coreArr
-    for(int i = 0; i<cores; i++)
-      coreArr[i] = NULL;
-
-}
-
-
-/**
-  Called when a new job arrives.
-  If multiple cores are idle, the job should be assigned to the core with the
-  lowest id.
-  If the job arriving should be scheduled to run during the next
-  time cycle, return the zero-based index of the core the job should be
-  scheduled on. If another job is already running on the core specified,
-  this will preempt the currently running job.
-  Assumptions:
-    - You may assume that every job wil have a unique arrival time.
-  @param job_number a globally unique identification number of the job arriving.
-  @param time the current time of the simulator.
-  @param running_time the total number of time units this job will run before it will be finished.
-  @param priority the priority of the job. (The lower the value, the higher the priority.)
-  @return index of core job should be scheduled on
-  @return -1 if no scheduling changes should be made.
- */
-
- // is it premptive? if so preempt;
-int scheduler_new_job(int job_number, int time, int running_time, int priority)
-{
-  //TODO: justin do this
-    job_t *temp = malloc(sizeof(job_t));
-    temp->pid = job_number;
-    temp->arrivalTime = time;
-    temp->runningTime = running_time;
-    temp->timeRemaining = running_time;
-    temp->priority = priority;
-
-    temp->responseTime = -1;
-
-    //single core
-    if(numCores == 1)
-    {
-      switch(schedScheme)
-      {
-        //non-preemptive
-        case FCFS :
-        case SJF :
-        case PRI :
-            if(coreArr[0] == NULL) {
-             //if not make it run on the core
-             coreArr[0] = temp;
-             coreArr[0]->responseTime = time - coreArr[0]->arrivalTime;
-             coreArr[0]->lastScheduled = time;
-             return(0);
-            } else {
-                priqueue_offer(&q, temp);
-                return(-1);
-            }
-        break;
-
-        //Preemptive
-        //check premption condition
-        case PPRI :
-            if(coreArr[0] == NULL) {
-             //if not make it run on the core
-             coreArr[0] = temp;
-             coreArr[0]->responseTime = time - coreArr[0]->arrivalTime;
-             return(0);
-            } else {
-                //if new job is of higher priority than job currently running on core
-                if( priority < coreArr[0]->priority || (priority == coreArr[0]->priority && coreArr[0]->arrivalTime > time)){
-                    //stop current job on core, put on queue
-                    if(coreArr[0]->lastScheduled == time){
-
-                        coreArr[0]->responseTime = -1;
-                    }
-                    priqueue_offer(&q, coreArr[0]);
-                    coreArr[0] = temp;
-                    coreArr[0]->responseTime = time - coreArr[0]->arrivalTime;
-                    return(0);
-
-                } else {
-                    priqueue_offer(&q, temp);
-                    return(-1);
-                }
-            }
-            break;
-        case PSJF :
-            if(coreArr[0] == NULL) {
-             //if not make it run on the core
-             coreArr[0] = temp;
-             coreArr[0]->responseTime = time - coreArr[0]->arrivalTime;
-             coreArr[0]->lastScheduled = time;
-             return(0);
-            } else {
-              int timeDiff = time - coreArr[0]->lastScheduled;
-              coreArr[0]->timeRemaining -= timeDiff;
-
-              /*
-                if the time difference is greater than the runtime of the new
-                job, then schedule the new job
-              */
-
-              if(coreArr[0]->timeRemaining > running_time)
-              {
-                  if(coreArr[0]->responseTime == time - coreArr[0]->arrivalTime){
-
-                        coreArr[0]->responseTime = -1;
-                  }
-                //remove job from core
-                //update its timeRemaining,
-                //add old job back to the queue
-                  priqueue_offer(&q, coreArr[0]);
-
-                //assign new job to the core
-                coreArr[0] = temp;
-                coreArr[0]->lastScheduled = time;
-                coreArr[0]->responseTime = time - coreArr[0]->arrivalTime;
-                return(0);
-              }else
-              {
-                //add new job to the priority queue
-                priqueue_offer(&q, temp);
-                return(-1);
-              }
-            }
-            break;
-        case RR :
-            if(coreArr[0] == NULL) {
-             //if not make it run on the core
-             coreArr[0] = temp;
-             coreArr[0]->responseTime = time - coreArr[0]->arrivalTime;
-             coreArr[0]->lastScheduled = time;
-             return(0);
-            } else {
-              priqueue_offer(&q, temp);
-            }
-
-            break;
-      }
-    } else {
-        //Multicore 
-        int coreIndex = -1;
-        //look for an open core
-        for(int i = 0; i < numCores; i++){
-            if(coreArr[i] == NULL){
-                //found one, break
-                coreIndex = i;
-                break;
-            }
-        }
-        //found a core to run on
-        if(coreIndex != -1){
-            coreArr[coreIndex] = temp;
-            coreArr[coreIndex]->responseTime = time - coreArr[coreIndex]->arrivalTime;
-            if(schedScheme == PSJF){
-              coreArr[coreIndex]->lastScheduled = time;
-            }
-            return(coreIndex);
-        } else { //otherwise we have to schedule
-
-            //only used in PSJF;
-            int lowestPriority;
-            int lowestIndex;
-            int tie;
-            switch(schedScheme)
-            {
-                //non-preemptive
-                case FCFS :
-                case SJF :
-                case PRI :
-                    priqueue_offer(&q, temp);
-                    return (-1);
-                break;
-
-                //Preemptive
-                //check premption contidtion
-                case PSJF :
-                //update time difference
-
-                //first time update
-                coreArr[0]->timeRemaining -=time - coreArr[0]->lastScheduled;
-                coreArr[0]->lastScheduled = time;
-
-
-                int highestRemTime = coreArr[0]->timeRemaining;
-                int highestIndex = 0;
-                // int lowestArrivalTime = coreArr[0]->arrivalTime;
-                // int lowestArrivalTimeIndex = 0;
-
-                //update remaining times and find lowest remaining time
-                for(int i = 1; i < numCores; i++)
-                {
-                    //calculate the new remaining time
-                    //int timeDiff = time - coreArr[i]->lastScheduled;
-                    //int timeDiff = time - prevTime;
-                    coreArr[i]->timeRemaining -= time - coreArr[i]->lastScheduled;
-                    coreArr[i]->lastScheduled = time;
-
-                    //see if the coreArr[i] remaining time is < than highestRemTime
-                    if(coreArr[i]->timeRemaining > highestRemTime)
-                    {
-                      highestIndex = i;
-                      highestRemTime = coreArr[i]->timeRemaining;
-                    }
-                }
-              //  prevTime = time;
-
-                //check if the lowest remaining time in the coreArr is greater
-                //than  the new job, if so, assign it to that core
-                if(highestRemTime > running_time)
-                {
-
-                  if(coreArr[highestIndex]->responseTime == (time - coreArr[highestIndex]->arrivalTime))
-                  {
-                    coreArr[highestIndex]->responseTime = -1;
-                  }
-                  priqueue_offer(&q, coreArr[highestIndex]);
-                  coreArr[highestIndex] = temp;
-                  //coreArr[highestIndex]->lastScheduled = time;
-
-                  if(coreArr[highestIndex]->responseTime == -1)
-                    coreArr[highestIndex]->responseTime = (time - coreArr[highestIndex]->arrivalTime);
-                  return(highestIndex);
-                } else {
-                  priqueue_offer(&q, temp);
-                  return -1;
-                }
-                break;
-                case PPRI :
-                    lowestPriority = coreArr[0]->priority;
-                    lowestIndex = 0;
-                    tie = 0;
-                    for(int i = 1; i < numCores; i++){
-
-                        //if lower priority then update lowest priority and lowest index
-                        if(coreArr[i]->priority > lowestPriority){
-
-                            lowestPriority = coreArr[i]->priority;
-                            lowestIndex = i;
-                            tie = 0;
-                        } else if (coreArr[i]->priority == lowestPriority){
-
-                            if(coreArr[i]->arrivalTime > coreArr[lowestIndex]->arrivalTime){
-
-                                    lowestIndex = i;
-                            }
-                        }
-                    }
-                    if(lowestPriority > priority){
-                        if(coreArr[lowestIndex]->lastScheduled == time){
-
-                            coreArr[lowestIndex]->responseTime = -1;
-                        }
-                        priqueue_offer(&q, coreArr[lowestIndex]);
-                        coreArr[lowestIndex] = temp;
-                        coreArr[lowestIndex]->responseTime = time - coreArr[lowestIndex]->arrivalTime;
-                        return lowestIndex;
-
-                    } else if (lowestPriority == priority){
-
-                        if(tie != 0){
-                            //start at lowest index and see which has the better run time
-                            for(int i=lowestIndex; i < numCores; i++){
-
-                                if(coreArr[i]->arrivalTime > coreArr[lowestIndex]->arrivalTime){
-                                    lowestIndex = i;
-                                }
-                            }
-                            if(coreArr[lowestIndex]->arrivalTime > time){
-                                if(coreArr[lowestIndex]->lastScheduled == time){
-
-                                    coreArr[lowestIndex]->responseTime = -1;
-                                }
-                                priqueue_offer(&q, coreArr[lowestIndex]);
-                                coreArr[lowestIndex] = temp;
-                                coreArr[lowestIndex]->responseTime = time - coreArr[lowestIndex]->arrivalTime;
-                                return lowestIndex;
-                            } else {
-                                priqueue_offer(&q, temp);
-                                return -1;
-                            }
-                        } else {
-                            if(coreArr[lowestIndex]->arrivalTime > time){
-                                if(coreArr[lowestIndex]->lastScheduled == time){
-
-                                    coreArr[lowestIndex]->responseTime = -1;
-                                }
-                                priqueue_offer(&q, coreArr[lowestIndex]);
-                                coreArr[lowestIndex] = temp;
-                                coreArr[lowestIndex]->responseTime = time - coreArr[lowestIndex]->arrivalTime;
-                                return lowestIndex;
-                            } else {
-                                priqueue_offer(&q, temp);
-                                return -1;
-                            }
-                        }
-                    } else {
-                        priqueue_offer(&q, temp);
-                        return -1;
-                    }
-
-                    break;
-                case RR :
-                    priqueue_offer(&q, temp);
-                    return -1;
-                    break;
-            }
-        }
-    }
-	return -1;
-}
-
-
-/**
-  Called when a job has completed execution.
--
-  The core_id, job_number and time parameters are provided for convenience. You may be able to calculate the values with your own data structure.
-  If any job should be scheduled to run on the core free'd up by the
-  finished job, return the job_number of the job that should be scheduled to
-  run on core core_id.
--
-  @param core_id the zero-based index of the core where the job was located.
-  @param job_number a globally unique identification number of the job.
-  @param time the current time of the simulator.
-  @return job_number of the job that should be scheduled to run on core core_id
-  @return -1 if core should remain idle.
- */
-int scheduler_job_finished(int core_id, int job_number, int time) {
-    //printf("\n\n\nRESPONSE TIME JOB %d is %d\n\n\n", coreArr[core_id]->pid, coreArr[core_id]->responseTime);
-    totalResponseTime += coreArr[core_id]->responseTime;
-    totalWaitingTime += time - coreArr[core_id]->arrivalTime - coreArr[core_id]->runningTime;
-    totalTATime +=time - coreArr[core_id]->arrivalTime;
-    numOfJobs++;
-    free(coreArr[core_id]);
-    coreArr[core_id] = NULL;
-    //if there's still a job to be done
-    if(priqueue_size(&q) > 0){
-        //get the next job
-        job_t* temp = (job_t*)priqueue_poll(&q);
-        //will have to do something for psjf
-        coreArr[core_id] = temp;
-        //set the response time that it's now been scheduled
-        if(coreArr[core_id]->responseTime == -1) {
-            coreArr[core_id]->lastScheduled = time;
-            coreArr[core_id]->responseTime = time - coreArr[core_id]->arrivalTime;
-        }
-        if(schedScheme == PSJF){
-          coreArr[core_id]->lastScheduled = time;
-            //printf("\n\n\nSCHEDULED JOB %d is %d\n\n\n", coreArr[core_id]->pid, coreArr[core_id]->responseTime);
-            if(coreArr[core_id]->responseTime == -1){
-                    coreArr[core_id]->responseTime = time - coreArr[core_id]->arrivalTime;
-                  //  coreArr[core_id]->lastScheduled = time;
-                   // printf("\n\n\nSCHEDULED JOB %d is %d\n\n\n", coreArr[core_id]->pid, coreArr[core_id]->responseTime);
-            }
-        }
-      return coreArr[core_id]->pid;
-    }
-
-    return -1;
-}
-
-/**
-  When the scheme is set to RR, called when the quantum timer has expired
-  on a core.
--
-  If any job should be scheduled to run on the core free'd up by
-  the quantum expiration, return the job_number of the job that should be
-  scheduled to run on core core_id.
--
-  @param core_id the zero-based index of the core where the quantum has expired.
-  @param time the current time of the simulator.
-  @return job_number of the job that should be scheduled on core cord_id
-  @return -1 if core should remain idle
- */
-int scheduler_quantum_expired(int core_id, int time)
-{
-    //only on the one core
-    //job on the core
-    job_t *temp = coreArr[core_id];
-    //if there's no job currently running on the core
-    if(temp == NULL) {
-        //if there's no job waiting in the queue
-        if(priqueue_size(&q) == 0){
-            return -1;
-        }
-    } else {
-        //otherwise put temp in the back of the queue
-        priqueue_offer(&q, temp);
-    }
-    //get the next job on the queue to begin running on the core
-    coreArr[core_id] = priqueue_poll(&q);
-    //if job hasn't yet been run
-    if(coreArr[core_id]->responseTime == -1){
-        //response = current time - arrival time
-        coreArr[core_id]->responseTime = time - coreArr[core_id]->arrivalTime;
-    }
-    return coreArr[core_id]->pid;
-}
-
-/**
-  Returns the average waiting time of all jobs scheduled by your scheduler.
-  Assumptions:
-    - This function will only be called after all scheduling is complete (all jobs that have arrived will have finished and no new jobs will arrive).
-  @return the average waiting time of all jobs scheduled.
- */
-float scheduler_average_waiting_time()
-{
-	return totalWaitingTime / numOfJobs;
-}
-
-/**
-  Returns the average turnaround time of all jobs scheduled by your scheduler.
-  Assumptions:
-    - This function will only be called after all scheduling is complete (all jobs that have arrived will have finished and no new jobs will arrive).
-  @return the average turnaround time of all jobs scheduled.
- */
-float scheduler_average_turnaround_time()
-{
-	return totalTATime/numOfJobs;
-}
-
-/**
-  Returns the average response time of all jobs scheduled by your scheduler.
-  Assumptions:
-    - This function will only be called after all scheduling is complete (all jobs that have arrived will have finished and no new jobs will arrive).
-  @return the average response time of all jobs scheduled.
- */
-float scheduler_average_response_time()
-{
-    return (totalResponseTime / numOfJobs);
-}
-
-/**
-  Free any memory associated with your scheduler.
-  Assumptions:
-    - This function will be the last function called in your library.
-*/
-void scheduler_clean_up()
-{
-  //TODO: Liia do this
-  //Free the core array
-  free(coreArr);
-}
-
-/**
-  This function may print out any debugging information you choose. This
-  function will be called by the simulator after every call the simulator
-  makes to your scheduler.
-  In our provided output, we have implemented this function to list the jobs in the order they are to be scheduled. Furthermore, we have also listed the current state of the job (either running on a given core or idle). For example, if we have a non-preemptive algorithm and job(id=4) has began running, job(id=2) arrives with a higher priority, and job(id=1) arrives with a lower priority, the output in our sample output will be:
-    2(-1) 4(0) 1(-1)
-  This function is not required and will not be graded. You may leave it
-  blank if you do not find it useful.
- */
-void scheduler_show_queue()
-{
-  //TODO: Liia do this
-  node_t* temp = q.mfront;
-  for(int i = 0; i< priqueue_size(&q); i++)
-  {
-    //print job and the core that its running on
-    job_t* valptr = (job_t*)(temp->mvalue);
-    //*job_t coreptr = (*job_t)(temp->mvalue);
-
-    printf("   %d (%d) ", valptr->pid, valptr->core);
-    temp = temp->mnext;
-  }
-}
+/** @file libscheduler.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libscheduler.h"
+#include "../libpriqueue/libpriqueue.h"
+
+priqueue_t q;
+
+/**
+  Stores information making up a job to be scheduled including any statistics.
+  You may need to define some global variables or a struct to store your job queue elements.
+*/
+typedef struct _job_t
+{
+    int row; //the job's row in jobTable, which holds its number, arrival time, running time, priority and cores
+    int timeRemaining; //running time - time it has been executed
+    int core; // zero indexed core on which the job is running, -1 if idle
+    int lastScheduled; //when the job was last scheduled to run
+    int responseTime;
+    int dispatchTime; //when the job was last put on a core, see job_descheduled()
+    int servedTime; //time spent on a core before dispatchTime
+    int workCarry; //work done in WORK_SCALE units of a time unit not yet taken off timeRemaining (only with core speeds)
+    int blockedTime; //total time spent blocked on I/O; while blocked, less the time it blocked at
+    node_t queueNode; //links the job into the run queue while it waits, so queueing it allocates nothing
+
+} job_t;
+
+/*
+  The job records, handed out from chunks of JOB_CHUNK that are aligned to a cache
+  line and never move, as the run queue links through the records. A record given
+  back goes on a free list, linked through its queue node, and is handed out next,
+  so a run needs as many records as it ever has jobs at once and no allocation per job.
+*/
+#define JOB_CHUNK 1024
+job_t **jobChunks;
+int numJobChunks;
+int jobChunkCap;
+int chunkUsed; //records handed out of the newest chunk
+job_t *freeJobs;
+
+/*
+  The job table the records point into by row: the caller's (see
+  scheduler_set_job_table()), or ownJobs, to which the scheduler adds the jobs
+  that arrive by value and from which it takes them out again when they leave
+*/
+const jobtable_t *jobTable;
+jobtable_t ownJobs;
+
+static inline int job_id(const job_t *job) { return jobTable->mjob_id[job->row]; }
+static inline int job_arrival(const job_t *job) { return jobTable->marrival_time[job->row]; }
+static inline int job_running(const job_t *job) { return jobTable->mrunning_time[job->row]; }
+static inline int job_priority(const job_t *job) { return jobTable->mpriority[job->row]; }
+static inline int job_cores(const job_t *job) { return jobTable->mcores[job->row]; }
+
+/*
+  array for cores, stores bools of whether a job is running on the core of that
+  index or not
+*/
+job_t* *coreArr;
+
+//number of cores we're using
+int numCores = 0;
+
+/*
+  The idle cores, one bit per core packed into words (bit i % 64 of word i / 64 is
+  set while coreArr[i] is NULL), so the lowest idle core is found a word at a time
+  (see core_assign()). Every word before idleHint is known to be all busy.
+*/
+unsigned long long *idleMask;
+int idleWords;
+int idleHint;
+int numIdle;
+
+scheme_t schedScheme;
+
+/*
+  The scheduling decisions for the scheme and core count in use, picked by
+  scheduler_start_up() (see SCHEME_PATH)
+*/
+typedef struct _scheme_paths_t
+{
+    int (*placed)(job_t *job, int time); //see job_placed_as()
+    int (*next)(int core_id, int time); //see dispatch_next_as()
+} scheme_paths_t;
+
+const scheme_paths_t *schedPaths;
+
+static const scheme_paths_t *scheme_paths(scheme_t scheme, int cores);
+
+/*
+  Per core speed factors, NULL while every core runs at speed 1 (see
+  scheduler_set_core_speeds()), and the same speeds as the work each core gets
+  through in a time unit, counted in WORK_SCALE units of a time unit as the
+  simulator counts it. Also the running totals that decide whether an arriving
+  job counts as short or high priority.
+*/
+#define WORK_SCALE 100
+
+double *coreSpeed;
+int *coreRate;
+long seenJobs;
+double seenRunningTime;
+double seenPriority;
+
+/*
+  Set once a job arrives through scheduler_new_gang_job(). A job then holds all of
+  its cores, each coreArr entry pointing at it, and its core field is the lowest of them.
+*/
+int gangScheduling;
+
+/*
+  Admission control (see scheduler_set_admission()), and the rows of the jobs
+  dropped from the queue to make room that scheduler_shed_jobs() has not handed out yet
+*/
+admission_t admission;
+int maxQueue;
+int admissionDeadline;
+int *shedRows;
+int numShed;
+int shedCap;
+
+/*
+  Aging under PRI and PPRI (see scheduler_set_aging()): what a priority level is
+  worth in the key, in time units of waiting. AGING_OFF makes any difference in
+  priority outweigh every difference in arrival time, and is the only setting
+  that keys a job by its arrival rather than by the time it has waited.
+*/
+#define AGING_OFF 4294967296LL
+long long agingScale;
+
+/*
+  The adaptive quantum under RR (see scheduler_set_quantum_target()): the latency
+  to aim for, 0 while the quantum is fixed, the bounds of the quantum, and the
+  running average of the bursts jobs ran before giving their core up by themselves
+*/
+int quantumLatency;
+int quantumMin;
+int quantumMax;
+double burstAverage;
+
+/*
+  The waiting time of the jobs finished so far, per priority, ordered by priority
+  (see scheduler_wait_classes())
+*/
+scheduler_wait_class_t *waitClasses;
+int numWaitClasses;
+int waitClassCap;
+
+/*
+  Jobs blocked on I/O, in no particular order (see scheduler_job_blocked()).
+  blockedSlot maps a job table row to its place in blockedJobs; an entry is only
+  meaningful while blockedJobs holds that row there, so it is never cleared.
+*/
+job_t **blockedJobs;
+int numBlocked;
+int blockedCap;
+int *blockedSlot;
+int blockedSlotCap;
+
+float totalWaitingTime; //total waiting time
+float totalResponseTime; //total response time
+float totalTATime; //total turnaround time
+int numOfJobs; //number of jobs for the scheduler
+
+/*
+  Internal counters, only maintained when built with SCHEDULER_STATS defined
+  (make STATS=1). Otherwise every STATS() statement compiles to nothing.
+*/
+#ifdef SCHEDULER_STATS
+#define STATS(stmt) do { stmt; } while(0)
+#else
+#define STATS(stmt) do { } while(0)
+#endif
+
+#ifdef SCHEDULER_STATS
+scheduler_stats_t schedStats;
+long *coreBusy; //per core time spent running a job
+long *coreIdle; //per core time spent idle
+int statsTime; //the last time the counters were brought up to date
+double queueArea; //integral of the queue length over time
+#endif
+
+/*
+  Brings the time weighted counters up to the given time. Must be called before
+  the queue or the cores change, so the elapsed interval is charged to the old state.
+*/
+static void stats_advance(int time)
+{
+#ifdef SCHEDULER_STATS
+    int elapsed = time - statsTime;
+    if(elapsed <= 0)
+        return;
+    queueArea += (double)priqueue_size(&q) * elapsed;
+    for(int i = 0; i < numCores; i++)
+    {
+        if(coreArr[i] != NULL)
+            coreBusy[i] += elapsed;
+        else
+            coreIdle[i] += elapsed;
+    }
+    statsTime = time;
+#endif
+}
+
+/*
+  The scheduling decisions are written once, as functions taking the scheme as
+  their first parameter, and compiled once per scheme (see schemePaths). Each
+  copy gets a constant scheme, so the switches on it and the branches for other
+  schemes fold away. SCHEME_PATH marks the functions such a copy is built from.
+  Building with SCHEDULER_GENERIC defined (make GENERIC=1) keeps a single copy
+  that switches on schedScheme at run time, for comparison.
+*/
+#define SCHEME_PATH static inline __attribute__((always_inline))
+
+/*
+  Sort key of a job in the run queue, lowest first. Jobs with equal keys stay in
+  the order they were offered, so each key reproduces its scheme's ordering:
+    FCFS  arrival time
+    SJF   running time
+    PSJF  remaining time (it does not change while the job waits)
+    PRI   priority, then arrival time; packed as priority<<32 | arrival. With
+          aging, priority * interval + arrival, which orders the jobs by their
+          priority less one level per interval waited, at any time
+    PPRI  same as PRI
+    RR    nothing, a constant key always appends to the back of the queue
+*/
+SCHEME_PATH long long job_key_as(scheme_t scheme, job_t *job)
+{
+    switch(scheme)
+    {
+      case FCFS :
+        return job_arrival(job);
+      case SJF :
+        return job_running(job);
+      case PSJF :
+        return job->timeRemaining;
+      case PRI :
+      case PPRI :
+        //multiply rather than shift, priorities may be negative
+        if(agingScale == AGING_OFF)
+            return (long long)job_priority(job) * agingScale + job_arrival(job);
+        //aged from the time it would have arrived had it waited all along: time on a core or blocked does not count
+        return (long long)job_priority(job) * agingScale + job_arrival(job) + job->servedTime + job->blockedTime;
+      case RR :
+        return 0;
+    }
+    return 0;
+}
+
+static long long job_key(job_t *job)
+{
+    return job_key_as(schedScheme, job);
+}
+
+/*
+  The key of a job on a core, to weigh against a waiting job's. With aging the
+  job stops aging while it runs, so its key moves on with the time since dispatch.
+*/
+SCHEME_PATH long long running_key_as(scheme_t scheme, job_t *job, int time)
+{
+    long long key = job_key_as(scheme, job);
+    if((scheme == PRI || scheme == PPRI) && agingScale != AGING_OFF)
+        key += time - job->dispatchTime;
+    return key;
+}
+
+/*
+  Every job entering or leaving the run queue goes through these two, so they are
+  the one place the queue counters need to be kept.
+*/
+SCHEME_PATH void queue_offer_as(scheme_t scheme, job_t *job)
+{
+    priqueue_offer_keyed(&q, job, job_key_as(scheme, job));
+    STATS(schedStats.offers++);
+    STATS(if(priqueue_size(&q) > schedStats.max_queue_depth) schedStats.max_queue_depth = priqueue_size(&q));
+}
+
+static void queue_offer(job_t *job)
+{
+    queue_offer_as(schedScheme, job);
+}
+
+static void queue_offer_all(job_t **jobs, int count)
+{
+    long long *keys = malloc(count * sizeof(long long));
+    for(int i = 0; i < count; i++)
+        keys[i] = job_key(jobs[i]);
+    priqueue_offer_all_keyed(&q, (void **)jobs, keys, count);
+    free(keys);
+    STATS(schedStats.offers += count);
+    STATS(if(priqueue_size(&q) > schedStats.max_queue_depth) schedStats.max_queue_depth = priqueue_size(&q));
+}
+
+static job_t *job_alloc()
+{
+    job_t *job = freeJobs;
+
+    if(job != NULL)
+    {
+        freeJobs = job->queueNode.mvalue;
+        return job;
+    }
+
+    if(numJobChunks == 0 || chunkUsed == JOB_CHUNK)
+    {
+        if(numJobChunks == jobChunkCap)
+        {
+            jobChunkCap = jobChunkCap > 0 ? jobChunkCap * 2 : 16;
+            jobChunks = realloc(jobChunks, jobChunkCap * sizeof(job_t *));
+        }
+        jobChunks[numJobChunks++] = aligned_alloc(64, JOB_CHUNK * sizeof(job_t));
+        chunkUsed = 0;
+    }
+    return &jobChunks[numJobChunks - 1][chunkUsed++];
+}
+
+static void job_free(job_t *job)
+{
+    if(jobTable == &ownJobs)
+        jobtable_remove(&ownJobs, job->row);
+    job->queueNode.mvalue = freeJobs;
+    freeJobs = job;
+}
+
+static job_t *queue_poll()
+{
+    STATS(schedStats.polls++);
+    return (job_t *)priqueue_poll(&q);
+}
+
+/*
+  The whole time units of work a job gets through on a core in elapsed time
+  units. With core speeds the fraction of a unit the job has done on top of them
+  is carried from one interval to the next (see job_worked()), not rounded off.
+*/
+static int work_done(const job_t *job, int core, int elapsed)
+{
+    if(coreRate == NULL)
+        return elapsed;
+    return (int)((job->workCarry + (long long)elapsed * coreRate[core]) / WORK_SCALE);
+}
+
+/*
+  Takes the work a job got through on a core in elapsed time units off its timeRemaining.
+*/
+static void job_worked(job_t *job, int core, int elapsed)
+{
+    if(coreRate == NULL)
+    {
+        job->timeRemaining -= elapsed;
+        return;
+    }
+    long long done = job->workCarry + (long long)elapsed * coreRate[core];
+    job->timeRemaining -= (int)(done / WORK_SCALE);
+    job->workCarry = (int)(done % WORK_SCALE);
+}
+
+/*
+  Called for a job taken off its core while it still has work left. PSJF keeps
+  timeRemaining up to date itself (through lastScheduled); for the other schemes
+  it is only needed when a snapshot is restored under PSJF, so it is brought up to
+  date here, from the time the job was dispatched.
+*/
+SCHEME_PATH void job_descheduled_as(scheme_t scheme, job_t *job, int core, int time)
+{
+    if(scheme != PSJF)
+        job_worked(job, core, time - job->dispatchTime);
+    job->servedTime += time - job->dispatchTime;
+}
+
+static void job_descheduled(job_t *job, int core, int time)
+{
+    job_descheduled_as(schedScheme, job, core, time);
+}
+
+/*
+  Puts a job on a core, or takes it off with NULL, keeping idleMask in step.
+  Every change to coreArr goes through here.
+*/
+static inline void core_assign(int core, job_t *job)
+{
+    unsigned long long bit = 1ULL << (core % 64);
+
+    if(job != NULL && coreArr[core] == NULL)
+    {
+        idleMask[core / 64] &= ~bit;
+        numIdle--;
+    }
+    else if(job == NULL && coreArr[core] != NULL)
+    {
+        idleMask[core / 64] |= bit;
+        numIdle++;
+        if(core / 64 < idleHint)
+            idleHint = core / 64;
+    }
+    coreArr[core] = job;
+}
+
+/*
+  The lowest idle core, -1 if there is none
+*/
+static inline int first_idle_core()
+{
+    for(; idleHint < idleWords; idleHint++)
+        if(idleMask[idleHint] != 0)
+            return idleHint * 64 + __builtin_ctzll(idleMask[idleHint]);
+    return -1;
+}
+
+/*
+  Picks the idle core for an arriving job, -1 if there is none. With every core
+  at the same speed that is the lowest idle id. Otherwise short jobs (SJF, PSJF)
+  and high priority jobs (PRI, PPRI), measured against the average of every job
+  seen so far, get the fastest idle core, and the rest the slowest, keeping the
+  fast cores free for the work that gains most from them. FCFS and RR have no
+  notion of either, so their jobs always get the fastest. Ties go to the lowest id.
+*/
+SCHEME_PATH int idle_core_as(scheme_t scheme, job_t *job)
+{
+    int best = -1;
+
+    if(coreSpeed == NULL)
+        return first_idle_core();
+
+    int fastest = 1;
+    if(scheme == SJF || scheme == PSJF)
+        fastest = job_running(job) * seenJobs <= seenRunningTime;
+    else if(scheme == PRI || scheme == PPRI)
+        fastest = job_priority(job) * seenJobs <= seenPriority;
+
+    for(int w = idleHint; w < idleWords; w++)
+    {
+        for(unsigned long long idle = idleMask[w]; idle != 0; idle &= idle - 1)
+        {
+            int i = w * 64 + __builtin_ctzll(idle);
+            if(best == -1 || (fastest ? coreSpeed[i] > coreSpeed[best] : coreSpeed[i] < coreSpeed[best]))
+                best = i;
+        }
+    }
+    return best;
+}
+
+static int idle_core(job_t *job)
+{
+    return idle_core_as(schedScheme, job);
+}
+
+/*
+  Adds an arriving job to the averages idle_core_as() measures against. Only
+  arrivals count, so a job coming back from I/O is not seen again.
+*/
+static void job_seen(job_t *job)
+{
+    if(coreSpeed == NULL)
+        return;
+    seenJobs++;
+    seenRunningTime += job_running(job);
+    seenPriority += job_priority(job);
+}
+
+/**
+  Initalizes the scheduler.
+  Assumptions:
+    - You may assume this will be the first scheduler function called.
+    - You may assume this function will be called once once.
+    - You may assume that cores is a positive, non-zero number.
+    - You may assume that scheme is a valid scheduling scheme.
+  @param cores the number of cores that is available by the scheduler. These cores will be known as core(id=0), core(id=1), ..., core(id=cores-1).
+  @param scheme  the scheduling scheme that should be used. This value will be one of the six enum values of scheme_t (from the header)
+*/
+void scheduler_start_up(int cores, scheme_t scheme)
+{
+    totalWaitingTime = 0.0; //total waiting time
+    totalResponseTime = 0.0; //total response time
+    totalTATime = 0.0; //total turnaround time
+    numOfJobs = 0;
+    //the queue is ordered by job_key(), which depends on the scheme. FCFS and RR jobs
+    //nearly always join in key order, so a ring queue appends and polls them in O(1)
+    if(scheme == FCFS || scheme == RR)
+        priqueue_init_ring(&q);
+    else
+        priqueue_init_intrusive(&q, NULL, offsetof(job_t, queueNode));
+
+    /*
+      setup and initialize cores to false
+    */
+    coreArr = malloc(cores*sizeof(job_t));
+
+    //set the global variable for cleanup later
+    numCores = cores;
+
+    schedScheme = scheme;
+    schedPaths = scheme_paths(scheme, cores);
+    //initialize the coreArr
+    for(int i = 0; i<cores; i++)
+      coreArr[i] = NULL;
+    //every core starts idle, the bits past the last core stay clear
+    idleWords = (cores + 63) / 64;
+    idleMask = malloc(idleWords * sizeof(unsigned long long));
+    for(int w = 0; w < idleWords; w++)
+      idleMask[w] = ~0ULL;
+    if(cores % 64 != 0)
+      idleMask[idleWords - 1] = (1ULL << (cores % 64)) - 1;
+    idleHint = 0;
+    numIdle = cores;
+
+    jobtable_init(&ownJobs, 16);
+    jobTable = &ownJobs;
+    coreSpeed = NULL;
+    coreRate = NULL;
+    agingScale = AGING_OFF;
+    quantumLatency = 0;
+    quantumMin = 0;
+    quantumMax = 0;
+    burstAverage = 0.0;
+    waitClasses = NULL;
+    numWaitClasses = 0;
+    waitClassCap = 0;
+    gangScheduling = 0;
+    admission = ADMIT_ALL;
+    maxQueue = 0;
+    admissionDeadline = 0;
+    shedRows = NULL;
+    numShed = 0;
+    shedCap = 0;
+    blockedJobs = NULL;
+    numBlocked = 0;
+    blockedCap = 0;
+    blockedSlot = NULL;
+    blockedSlotCap = 0;
+    seenJobs = 0;
+    seenRunningTime = 0.0;
+    seenPriority = 0.0;
+
+#ifdef SCHEDULER_STATS
+    memset(&schedStats, 0, sizeof(schedStats));
+    coreBusy = calloc(cores, sizeof(long));
+    coreIdle = calloc(cores, sizeof(long));
+    statsTime = 0;
+    queueArea = 0.0;
+#endif
+
+}
+
+
+/**
+  Makes the scheduler work on the caller's job table instead of keeping one of its
+  own, so each job's number, arrival time, running time, priority and cores are
+  stored once. Jobs then arrive by their row, through scheduler_new_jobs() and
+  scheduler_new_gang_row(). The caller keeps a job in its row, unchanged, until
+  scheduler_job_finished() has been called for it or it was rejected or shed.
+  Call it after scheduler_start_up() before any job arrives; scheduler_restore()
+  takes the table itself.
+  @param jobs the job table.
+ */
+void scheduler_set_job_table(const jobtable_t *jobs)
+{
+    jobTable = jobs;
+}
+
+
+/**
+  Gives the cores different speeds. A core of speed 2 gets through two time units
+  of a job's running time in every time unit. Call it after scheduler_start_up(),
+  or scheduler_restore(), before any job arrives; without it every core runs at
+  speed 1 and is chosen lowest id first.
+  @param speeds the speed of each core, all positive.
+ */
+void scheduler_set_core_speeds(const double *speeds)
+{
+    free(coreSpeed);
+    free(coreRate);
+    coreSpeed = malloc(numCores * sizeof(double));
+    coreRate = malloc(numCores * sizeof(int));
+    memcpy(coreSpeed, speeds, numCores * sizeof(double));
+    for(int i = 0; i < numCores; i++)
+        coreRate[i] = (int)(speeds[i] * WORK_SCALE + 0.5);
+}
+
+
+/**
+  Bounds the run queue. An arriving job that would have to wait when max_queue
+  jobs are already waiting is dealt with by the policy:
+    ADMIT_REJECT_NEWEST  the arriving job is rejected
+    ADMIT_DROP_LOWEST    the job of lowest priority, the latest to arrive among
+                         equals, is dropped: the arriving job is rejected if it is
+                         that job, otherwise the queued one is shed
+    ADMIT_DEADLINE       as ADMIT_REJECT_NEWEST, and an arriving job whose expected
+                         wait is over deadline is rejected even when there is room
+  The expected wait is the work still to do on the cores and ahead of the job in
+  the queue, shared over the cores. Jobs preempted by an arrival, or back from
+  I/O, have been admitted already and always go back in the queue.
+  Call it after scheduler_start_up(), or scheduler_restore(); without it every job
+  is admitted. It does not apply to scheduler_new_gang_job().
+  @param max_queue the most jobs that may wait, at least 0.
+  @param policy what to do with a job that does not fit, ADMIT_ALL to admit every job.
+  @param deadline the longest expected wait admitted, for ADMIT_DEADLINE.
+ */
+void scheduler_set_admission(int max_queue, admission_t policy, int deadline)
+{
+    admission = policy;
+    maxQueue = max_queue;
+    admissionDeadline = deadline;
+}
+
+/**
+  Makes waiting jobs gain priority under PRI and PPRI, so none of them can starve:
+  a job's priority counts as one level better for every interval time units it
+  has spent waiting in the queue; time on a core or blocked on I/O does not count.
+  Jobs are ordered, and preempt under PPRI, by that aged priority. The queue never
+  needs reordering, since waiting the same time ages every job alike. The other
+  schemes are not affected.
+  Call it after scheduler_start_up(), or scheduler_restore(), whose queued jobs it
+  orders again; without it the priorities never change.
+  @param interval the time units of waiting worth one priority level, 0 for no aging.
+ */
+void scheduler_set_aging(int interval)
+{
+    agingScale = interval > 0 ? interval : AGING_OFF;
+
+    int count = priqueue_size(&q);
+    if(count == 0)
+        return;
+    job_t **jobs = malloc(count * sizeof(job_t *));
+    for(int i = 0; i < count; i++)
+        jobs[i] = priqueue_poll(&q);
+    for(int i = 0; i < count; i++)
+        priqueue_offer_keyed(&q, jobs[i], job_key(jobs[i]));
+    free(jobs);
+}
+
+/**
+  Makes the RR quantum adapt to the load instead of being fixed: every job that
+  wants a core should get one within the target latency, so the more jobs are
+  runnable, the shorter the quantum each of them gets (see scheduler_core_quantum()).
+  The other schemes are not affected.
+  Call it after scheduler_start_up(); without it the caller keeps its own quantum.
+  @param latency the time units within which every runnable job should be run, 0
+  to go back to a fixed quantum.
+  @param min_quantum the shortest quantum to hand out, at least 1.
+  @param max_quantum the longest quantum to hand out, at least min_quantum.
+ */
+void scheduler_set_quantum_target(int latency, int min_quantum, int max_quantum)
+{
+    quantumLatency = latency;
+    quantumMin = min_quantum;
+    quantumMax = max_quantum;
+}
+
+/*
+  Adds how long a job ran since it was put on its core, when it gives the core up
+  by itself, to the average burst (an exponential average weighing the newest 1/8)
+*/
+static void burst_observed(job_t *job, int time)
+{
+    int burst = time - job->dispatchTime;
+
+    if(burstAverage == 0.0)
+        burstAverage = burst;
+    else
+        burstAverage += (burst - burstAverage) / 8;
+}
+
+/*
+  Adds the waiting time of a finished job to its priority's class
+*/
+static void wait_class_add(int priority, int wait)
+{
+    int lo = 0, hi = numWaitClasses;
+    while(lo < hi)
+    {
+        int mid = (lo + hi) / 2;
+        if(waitClasses[mid].priority < priority)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if(lo == numWaitClasses || waitClasses[lo].priority != priority)
+    {
+        if(numWaitClasses == waitClassCap)
+        {
+            waitClassCap = waitClassCap > 0 ? waitClassCap * 2 : 8;
+            waitClasses = realloc(waitClasses, waitClassCap * sizeof(scheduler_wait_class_t));
+        }
+        memmove(waitClasses + lo + 1, waitClasses + lo, (numWaitClasses - lo) * sizeof(scheduler_wait_class_t));
+        numWaitClasses++;
+        waitClasses[lo].priority = priority;
+        waitClasses[lo].jobs = 0;
+        waitClasses[lo].max_wait = 0;
+        waitClasses[lo].total_wait = 0.0;
+    }
+
+    waitClasses[lo].jobs++;
+    waitClasses[lo].total_wait += wait;
+    if(wait > waitClasses[lo].max_wait)
+        waitClasses[lo].max_wait = wait;
+}
+
+/**
+  Hands out all the jobs shed from the queue since the last call. A shed job is
+  gone from the scheduler, it will never run or finish.
+  @param rows set to the rows of the jobs in the job table given to
+  scheduler_set_job_table(), in the order they were shed; they stay valid until
+  the next job arrives.
+  @return the number of jobs shed
+ */
+int scheduler_shed_jobs(const int **rows)
+{
+    int count = numShed;
+
+    *rows = shedRows;
+    numShed = 0;
+    return count;
+}
+
+/*
+  The work a job would wait for if it joined the queue now: what the running jobs
+  have left and the work of the jobs ahead of it, shared over the cores.
+*/
+static double expected_wait(job_t *job, int time)
+{
+    double work = 0;
+    priqueue_iter_t it;
+    job_t *waiting;
+
+    for(int i = 0; i < numCores; i++)
+    {
+        if(coreArr[i] == NULL)
+            continue;
+        int since = (schedScheme == PSJF) ? coreArr[i]->lastScheduled : coreArr[i]->dispatchTime;
+        int left = coreArr[i]->timeRemaining - work_done(coreArr[i], i, time - since);
+        work += left > 0 ? left : 0;
+    }
+
+    priqueue_iter_begin(&q, &it);
+    while((waiting = priqueue_iter_next(&it)) != NULL && waiting != job)
+        work += waiting->timeRemaining;
+
+    return work / numCores;
+}
+
+/*
+  Applies the admission policy to a job that has just arrived and been put in the
+  queue, now that the queue may be over its bound.
+  @return 1 if the job stays, 0 if it was taken out of the queue and freed
+*/
+static int job_admitted(job_t *job, int time)
+{
+    if(admission == ADMIT_DEADLINE && expected_wait(job, time) > admissionDeadline)
+    {
+        priqueue_remove(&q, job);
+        job_free(job);
+        return 0;
+    }
+
+    if(priqueue_size(&q) <= maxQueue)
+        return 1;
+
+    job_t *victim = job;
+    if(admission == ADMIT_DROP_LOWEST)
+    {
+        priqueue_iter_t it;
+        job_t *waiting;
+
+        priqueue_iter_begin(&q, &it);
+        while((waiting = priqueue_iter_next(&it)) != NULL)
+            if(job_priority(waiting) > job_priority(victim) ||
+               (job_priority(waiting) == job_priority(victim) && job_arrival(waiting) > job_arrival(victim)))
+                victim = waiting;
+    }
+
+    priqueue_remove(&q, victim);
+    if(victim == job)
+    {
+        job_free(job);
+        return 0;
+    }
+
+    if(numShed == shedCap)
+    {
+        shedCap = shedCap > 0 ? shedCap * 2 : 16;
+        shedRows = realloc(shedRows, shedCap * sizeof(int));
+    }
+    shedRows[numShed++] = victim->row;
+    job_free(victim);
+    return 1;
+}
+
+/*
+  Decides where a job that has become ready, a new arrival or a job back from I/O,
+  runs: on a core (possibly preempting another job), whose index is returned, or
+  in the queue, and -1 is returned. A job back from I/O competes with the running
+  jobs on what it has left (PSJF) and its original arrival time (PPRI ties).
+  single is set when there is only one core.
+*/
+SCHEME_PATH int job_placed_as(scheme_t scheme, int single, job_t *temp, int time)
+{
+    //single core
+    if(single)
+    {
+      switch(scheme)
+      {
+        //non-preemptive
+        case FCFS :
+        case SJF :
+        case PRI :
+            if(coreArr[0] == NULL) {
+             //if not make it run on the core
+             core_assign(0, temp);
+             coreArr[0]->responseTime = time - job_arrival(coreArr[0]);
+             coreArr[0]->lastScheduled = time;
+             return(0);
+            } else {
+                queue_offer_as(scheme, temp);
+                return(-1);
+            }
+        break;
+
+        //Preemptive
+        //check premption condition
+        case PPRI :
+            if(coreArr[0] == NULL) {
+             //if not make it run on the core
+             core_assign(0, temp);
+             coreArr[0]->responseTime = time - job_arrival(coreArr[0]);
+             return(0);
+            } else {
+                //if new job is of higher (aged) priority than job currently running on core, earlier arrival breaking ties
+                if(job_key_as(scheme, temp) < running_key_as(scheme, coreArr[0], time)){
+                    //stop current job on core, put on queue
+                    if(coreArr[0]->lastScheduled == time){
+
+                        coreArr[0]->responseTime = -1;
+                    }
+                    job_descheduled_as(scheme, coreArr[0], 0, time);
+                    queue_offer_as(scheme, coreArr[0]);
+                    STATS(schedStats.preemptions++);
+                    core_assign(0, temp);
+                    coreArr[0]->responseTime = time - job_arrival(coreArr[0]);
+                    return(0);
+
+                } else {
+                    queue_offer_as(scheme, temp);
+                    return(-1);
+                }
+            }
+            break;
+        case PSJF :
+            if(coreArr[0] == NULL) {
+             //if not make it run on the core
+             core_assign(0, temp);
+             coreArr[0]->responseTime = time - job_arrival(coreArr[0]);
+             coreArr[0]->lastScheduled = time;
+             return(0);
+            } else {
+              int timeDiff = time - coreArr[0]->lastScheduled;
+              job_worked(coreArr[0], 0, timeDiff);
+
+              /*
+                if the time difference is greater than the runtime of the new
+                job, then schedule the new job
+              */
+
+              if(coreArr[0]->timeRemaining > temp->timeRemaining)
+              {
+                  if(coreArr[0]->responseTime == time - job_arrival(coreArr[0])){
+
+                        coreArr[0]->responseTime = -1;
+                  }
+                //remove job from core
+                //update its timeRemaining,
+                //add old job back to the queue
+                  job_descheduled_as(scheme, coreArr[0], 0, time);
+                  queue_offer_as(scheme, coreArr[0]);
+                  STATS(schedStats.preemptions++);
+
+                //assign new job to the core
+                core_assign(0, temp);
+                coreArr[0]->lastScheduled = time;
+                coreArr[0]->responseTime = time - job_arrival(coreArr[0]);
+                return(0);
+              }else
+              {
+                //add new job to the temp->priority queue
+                queue_offer_as(scheme, temp);
+                return(-1);
+              }
+            }
+            break;
+        case RR :
+            if(coreArr[0] == NULL) {
+             //if not make it run on the core
+             core_assign(0, temp);
+             coreArr[0]->responseTime = time - job_arrival(coreArr[0]);
+             coreArr[0]->lastScheduled = time;
+             return(0);
+            } else {
+              queue_offer_as(scheme, temp);
+            }
+
+            break;
+      }
+    } else {
+        //Multicore 
+        //look for an open core
+        int coreIndex = idle_core_as(scheme, temp);
+        //found a core to run on
+        if(coreIndex != -1){
+            core_assign(coreIndex, temp);
+            coreArr[coreIndex]->responseTime = time - job_arrival(coreArr[coreIndex]);
+            if(scheme == PSJF){
+              coreArr[coreIndex]->lastScheduled = time;
+            }
+            return(coreIndex);
+        } else { //otherwise we have to schedule
+
+            //only used in PPRI
+            long long lowestKey;
+            int lowestIndex;
+            switch(scheme)
+            {
+                //non-preemptive
+                case FCFS :
+                case SJF :
+                case PRI :
+                    queue_offer_as(scheme, temp);
+                    return (-1);
+                break;
+
+                //Preemptive
+                //check premption contidtion
+                case PSJF :
+                //update time difference
+
+                //first time update
+                job_worked(coreArr[0], 0, time - coreArr[0]->lastScheduled);
+                coreArr[0]->lastScheduled = time;
+
+
+                int highestRemTime = coreArr[0]->timeRemaining;
+                int highestIndex = 0;
+                // int lowestArrivalTime = coreArr[0]->arrivalTime;
+                // int lowestArrivalTimeIndex = 0;
+
+                //update remaining times and find lowest remaining time
+                for(int i = 1; i < numCores; i++)
+                {
+                    //calculate the new remaining time
+                    //int timeDiff = time - coreArr[i]->lastScheduled;
+                    //int timeDiff = time - prevTime;
+                    job_worked(coreArr[i], i, time - coreArr[i]->lastScheduled);
+                    coreArr[i]->lastScheduled = time;
+
+                    //see if the coreArr[i] remaining time is < than highestRemTime
+                    if(coreArr[i]->timeRemaining > highestRemTime)
+                    {
+                      highestIndex = i;
+                      highestRemTime = coreArr[i]->timeRemaining;
+                    }
+                }
+              //  prevTime = time;
+
+                //check if the lowest remaining time in the coreArr is greater
+                //than  the new job, if so, assign it to that core
+                if(highestRemTime > temp->timeRemaining)
+                {
+
+                  if(coreArr[highestIndex]->responseTime == (time - job_arrival(coreArr[highestIndex])))
+                  {
+                    coreArr[highestIndex]->responseTime = -1;
+                  }
+                  job_descheduled_as(scheme, coreArr[highestIndex], highestIndex, time);
+                  queue_offer_as(scheme, coreArr[highestIndex]);
+                  STATS(schedStats.preemptions++);
+                  core_assign(highestIndex, temp);
+                  coreArr[highestIndex]->lastScheduled = time;
+
+                  if(coreArr[highestIndex]->responseTime == -1)
+                    coreArr[highestIndex]->responseTime = (time - job_arrival(coreArr[highestIndex]));
+                  return(highestIndex);
+                } else {
+                  queue_offer_as(scheme, temp);
+                  return -1;
+                }
+                break;
+                case PPRI :
+                    //the running job of lowest (aged) priority, the latest to arrive among equals, lowest core on ties
+                    lowestKey = running_key_as(scheme, coreArr[0], time);
+                    lowestIndex = 0;
+                    for(int i = 1; i < numCores; i++){
+                        long long key = running_key_as(scheme, coreArr[i], time);
+                        if(key > lowestKey){
+                            lowestKey = key;
+                            lowestIndex = i;
+                        }
+                    }
+                    if(lowestKey > job_key_as(scheme, temp)){
+                        if(coreArr[lowestIndex]->lastScheduled == time){
+
+                            coreArr[lowestIndex]->responseTime = -1;
+                        }
+                        job_descheduled_as(scheme, coreArr[lowestIndex], lowestIndex, time);
+                        queue_offer_as(scheme, coreArr[lowestIndex]);
+                        STATS(schedStats.preemptions++);
+                        core_assign(lowestIndex, temp);
+                        coreArr[lowestIndex]->responseTime = time - job_arrival(coreArr[lowestIndex]);
+                        return lowestIndex;
+                    } else {
+                        queue_offer_as(scheme, temp);
+                        return -1;
+                    }
+
+                    break;
+                case RR :
+                    queue_offer_as(scheme, temp);
+                    return -1;
+                    break;
+            }
+        }
+    }
+	return -1;
+}
+
+
+/*
+  Gives a core that has just been freed the job at the head of the queue.
+  @return job_number of the job now running on core core_id
+  @return -1 if the queue is empty and the core stays idle
+*/
+SCHEME_PATH int dispatch_next_as(scheme_t scheme, int core_id, int time)
+{
+    //if there's still a job to be done
+    if(priqueue_size(&q) > 0){
+        //get the next job
+        job_t* temp = (job_t*)queue_poll();
+        //will have to do something for psjf
+        core_assign(core_id, temp);
+        temp->dispatchTime = time;
+        //set the response time that it's now been scheduled
+        if(coreArr[core_id]->responseTime == -1) {
+            coreArr[core_id]->lastScheduled = time;
+            coreArr[core_id]->responseTime = time - job_arrival(coreArr[core_id]);
+        }
+        if(scheme == PSJF){
+          coreArr[core_id]->lastScheduled = time;
+            //printf("\n\n\nSCHEDULED JOB %d is %d\n\n\n", coreArr[core_id]->pid, coreArr[core_id]->responseTime);
+            if(coreArr[core_id]->responseTime == -1){
+                    coreArr[core_id]->responseTime = time - job_arrival(coreArr[core_id]);
+                  //  coreArr[core_id]->lastScheduled = time;
+                   // printf("\n\n\nSCHEDULED JOB %d is %d\n\n\n", coreArr[core_id]->pid, coreArr[core_id]->responseTime);
+            }
+        }
+      return job_id(coreArr[core_id]);
+    }
+
+    return -1;
+}
+
+/*
+  One copy of the decisions per scheme, and for one core or several. Each entry
+  of schemePaths is indexed by scheme_t, then by whether there is a single core.
+*/
+#ifndef SCHEDULER_GENERIC
+#define SCHEME_PATHS(scheme, name) \
+    static int job_placed_##name(job_t *job, int time) { return job_placed_as(scheme, 0, job, time); } \
+    static int job_placed_##name##_single(job_t *job, int time) { return job_placed_as(scheme, 1, job, time); } \
+    static int dispatch_next_##name(int core_id, int time) { return dispatch_next_as(scheme, core_id, time); }
+
+SCHEME_PATHS(FCFS, fcfs)
+SCHEME_PATHS(SJF, sjf)
+SCHEME_PATHS(PSJF, psjf)
+SCHEME_PATHS(PRI, pri)
+SCHEME_PATHS(PPRI, ppri)
+SCHEME_PATHS(RR, rr)
+
+#define SCHEME_PATHS_ENTRY(name) \
+    { { job_placed_##name, dispatch_next_##name }, { job_placed_##name##_single, dispatch_next_##name } }
+
+static const scheme_paths_t schemePaths[][2] =
+{
+    SCHEME_PATHS_ENTRY(fcfs),
+    SCHEME_PATHS_ENTRY(sjf),
+    SCHEME_PATHS_ENTRY(psjf),
+    SCHEME_PATHS_ENTRY(pri),
+    SCHEME_PATHS_ENTRY(ppri),
+    SCHEME_PATHS_ENTRY(rr)
+};
+#else
+static int job_placed_generic(job_t *job, int time) { return job_placed_as(schedScheme, numCores == 1, job, time); }
+static int dispatch_next_generic(int core_id, int time) { return dispatch_next_as(schedScheme, core_id, time); }
+
+static const scheme_paths_t genericPaths = { job_placed_generic, dispatch_next_generic };
+#endif
+
+static const scheme_paths_t *scheme_paths(scheme_t scheme, int cores)
+{
+#ifndef SCHEDULER_GENERIC
+    return &schemePaths[scheme][cores == 1];
+#else
+    (void)scheme;
+    (void)cores;
+    return &genericPaths;
+#endif
+}
+
+static int job_placed(job_t *job, int time)
+{
+    return schedPaths->placed(job, time);
+}
+
+static int dispatch_next(int core_id, int time)
+{
+    return schedPaths->next(core_id, time);
+}
+
+/*
+  A fresh record for the job that has just arrived in a row of the job table
+*/
+static job_t *job_new(int row, int time)
+{
+    job_t *job = job_alloc();
+
+    job->row = row;
+    job->timeRemaining = job_running(job);
+    job->core = -1;
+    job->dispatchTime = time;
+    job->servedTime = 0;
+    job->workCarry = 0;
+    job->blockedTime = 0;
+    job->responseTime = -1;
+    return job;
+}
+
+/*
+  Schedules the job that has just arrived in a row of the job table, see scheduler_new_job()
+*/
+static int job_arrived(int row, int time)
+{
+    job_t *temp = job_new(row, time);
+
+    stats_advance(time);
+    job_seen(temp);
+    int core = job_placed(temp, time);
+    if(core == -1 && admission != ADMIT_ALL && !job_admitted(temp, time))
+        return SCHEDULER_REJECTED;
+    return core;
+}
+
+/**
+  Called when a new job arrives.
+  If multiple cores are idle, the job should be assigned to the core with the
+  lowest id.
+  If the job arriving should be scheduled to run during the next
+  time cycle, return the zero-based index of the core the job should be
+  scheduled on. If another job is already running on the core specified,
+  this will preempt the currently running job.
+  Assumptions:
+    - You may assume that every job wil have a unique arrival time.
+    - The scheduler keeps its own job table (see scheduler_set_job_table()).
+  @param job_number a globally unique identification number of the job arriving.
+  @param time the current time of the simulator.
+  @param running_time the total number of time units this job will run before it will be finished.
+  @param priority the priority of the job. (The lower the value, the higher the priority.)
+  @return index of core job should be scheduled on
+  @return -1 if no scheduling changes should be made.
+  @return SCHEDULER_REJECTED if the job was not admitted (see scheduler_set_admission()).
+ */
+
+ // is it premptive? if so preempt;
+int scheduler_new_job(int job_number, int time, int running_time, int priority)
+{
+  //TODO: justin do this
+    return job_arrived(jobtable_add(&ownJobs, job_number, time, running_time, priority, 1), time);
+}
+
+
+/*
+  Orders a batch of arrivals by job number
+*/
+static int arrival_comparer(const void *a, const void *b)
+{
+    const scheduler_arrival_t *arrA = (const scheduler_arrival_t *)a;
+    const scheduler_arrival_t *arrB = (const scheduler_arrival_t *)b;
+    return (arrA->job_number > arrB->job_number) - (arrA->job_number < arrB->job_number);
+}
+
+/**
+  Called when several jobs arrive in the same time unit.
+  The jobs are handled in order of job_number, so ties are always broken the same
+  way. The result is the same as calling scheduler_new_job() for each of them in
+  that order, but for the non-preemptive schemes (FCFS, SJF, PRI and RR) the jobs
+  left waiting are inserted into the queue in a single merge pass instead of one
+  O(n) insert each. PSJF and PPRI decide preemption one job at a time, and so
+  does every scheme under admission control (see scheduler_set_admission()).
+  With a job table (see scheduler_set_job_table()) each job is given by its row,
+  and only its job_number is read besides.
+  @param jobs the arriving jobs. The array is sorted by job_number, and each
+  element's core is set to the core the job is running on once the whole batch has
+  been scheduled, or -1 if it is waiting (including a job that was preempted by a
+  later job of the same batch), or SCHEDULER_REJECTED if it was not admitted.
+  @param count the number of jobs in the batch.
+  @param time the current time of the simulator.
+  @return the number of jobs of the batch that are running on a core
+ */
+int scheduler_new_jobs(scheduler_arrival_t *jobs, int count, int time)
+{
+    int running = 0;
+
+    qsort(jobs, count, sizeof(scheduler_arrival_t), arrival_comparer);
+    for(int i = 0; jobTable == &ownJobs && i < count; i++)
+        jobs[i].row = jobtable_add(&ownJobs, jobs[i].job_number, time, jobs[i].running_time, jobs[i].priority, 1);
+
+    if(schedScheme == PSJF || schedScheme == PPRI || admission != ADMIT_ALL)
+    {
+        //every arrival may preempt, or be turned away, one at a time
+        for(int i = 0; i < count; i++)
+        {
+            jobs[i].core = job_arrived(jobs[i].row, time);
+            if(jobs[i].core < 0)
+                continue;
+            //an earlier job of this batch may have just lost its core
+            for(int j = 0; j < i; j++)
+            {
+                if(jobs[j].core == jobs[i].core)
+                {
+                    jobs[j].core = -1;
+                    running--;
+                }
+            }
+            running++;
+        }
+        return running;
+    }
+
+    stats_advance(time);
+
+    job_t **waiting = malloc(count * sizeof(job_t *));
+    int numWaiting = 0;
+    for(int i = 0; i < count; i++)
+    {
+        job_t *temp = job_new(jobs[i].row, time);
+        job_seen(temp);
+
+        //idle cores are handed out exactly like scheduler_new_job, lowest id first at equal speeds
+        int coreIndex = idle_core(temp);
+        if(coreIndex != -1)
+        {
+            core_assign(coreIndex, temp);
+            temp->responseTime = 0;
+            temp->lastScheduled = time;
+            jobs[i].core = coreIndex;
+            running++;
+        } else {
+            waiting[numWaiting++] = temp;
+            jobs[i].core = -1;
+        }
+    }
+    queue_offer_all(waiting, numWaiting);
+    free(waiting);
+    return running;
+}
+
+
+/*
+  Number of cores with no job on them.
+*/
+static int idle_cores()
+{
+    return numIdle;
+}
+
+/*
+  Puts a gang job on the lowest idle cores, enough of them for the whole job.
+*/
+static void gang_start(job_t *job, int time)
+{
+    int needed = job_cores(job), i;
+
+    job->core = -1;
+    while(needed > 0 && (i = first_idle_core()) != -1)
+    {
+        core_assign(i, job);
+        if(job->core == -1)
+            job->core = i;
+        needed--;
+    }
+
+    job->dispatchTime = time;
+    job->lastScheduled = time;
+    if(job->responseTime == -1)
+        job->responseTime = time - job_arrival(job);
+}
+
+/*
+  The time the job at the head of the queue is sure to start, the shadow time: the
+  first point at which the running jobs, each of which runs to the end of its
+  running time, have freed enough cores for it. extra is set to the cores left over
+  at that point, which a backfilled job may keep past the shadow time.
+*/
+static int gang_shadow(job_t *head, int time, int *extra)
+{
+    int count = 0, freed = idle_cores();
+    int *ends = malloc(numCores * sizeof(int));
+    int *held = malloc(numCores * sizeof(int));
+    int shadow = time;
+
+    for(int i = 0; i < numCores; i++)
+    {
+        //each running job once, at its lowest core
+        if(coreArr[i] == NULL || coreArr[i]->core != i)
+            continue;
+        //insertion sort by end time, the cores are few
+        int end = coreArr[i]->dispatchTime + coreArr[i]->timeRemaining, j = count++;
+        while(j > 0 && ends[j - 1] > end)
+        {
+            ends[j] = ends[j - 1];
+            held[j] = held[j - 1];
+            j--;
+        }
+        ends[j] = end;
+        held[j] = job_cores(coreArr[i]);
+    }
+
+    for(int i = 0; i < count && freed < job_cores(head); i++)
+    {
+        freed += held[i];
+        shadow = ends[i];
+    }
+
+    *extra = freed - job_cores(head);
+    free(ends);
+    free(held);
+    return shadow;
+}
+
+/*
+  Starts jobs under gang scheduling (EASY backfilling). Jobs start in queue order
+  while the one at the head fits in the idle cores. When it does not, the jobs
+  behind it may use the idle cores anyway, if they finish by the head's shadow time
+  or only use cores it will not need then, so the head is never delayed.
+*/
+static void gang_dispatch(int time)
+{
+    job_t *head;
+    int idle = idle_cores();
+
+    while((head = priqueue_peek(&q)) != NULL && job_cores(head) <= idle)
+    {
+        gang_start(queue_poll(), time);
+        idle -= job_cores(head);
+    }
+
+    if(head == NULL || idle == 0)
+        return;
+
+    int extra, shadow = gang_shadow(head, time, &extra);
+    int count = priqueue_size(&q);
+    job_t **waiting = malloc(count * sizeof(job_t *));
+
+    priqueue_to_array(&q, (void **)waiting, count);
+    for(int i = 1; i < count && idle > 0; i++)
+    {
+        job_t *job = waiting[i];
+        int before_shadow = time + job->timeRemaining <= shadow;
+
+        if(job_cores(job) > idle || (!before_shadow && job_cores(job) > extra))
+            continue;
+
+        priqueue_remove(&q, job);
+        STATS(schedStats.polls++);
+        STATS(schedStats.backfills++);
+        gang_start(job, time);
+        idle -= job_cores(job);
+        if(!before_shadow)
+            extra -= job_cores(job);
+    }
+    free(waiting);
+}
+
+/**
+  Called instead of scheduler_new_job() for a job that needs several cores at
+  once (a gang). It puts the scheduler into gang scheduling: every job then holds
+  all of its cores from the moment it starts until it finishes, and jobs behind a
+  gang that does not fit yet may start in the idle cores as long as they do not
+  delay it (EASY backfilling). As one call may start several jobs,
+  scheduler_core_job() tells which job is on each core.
+  Assumptions:
+    - The scheme is FCFS, SJF or PRI, jobs are never preempted.
+    - Every job arrives through this function (or scheduler_new_gang_row()), and cores is at most the number of cores.
+    - The scheduler keeps its own job table (see scheduler_set_job_table()).
+  @param job_number a globally unique identification number of the job arriving.
+  @param time the current time of the simulator.
+  @param running_time the total number of time units this job will run before it will be finished.
+  @param priority the priority of the job. (The lower the value, the higher the priority.)
+  @param cores the number of cores the job needs.
+  @return the lowest of the cores the job is running on
+  @return -1 if the job is waiting.
+ */
+int scheduler_new_gang_job(int job_number, int time, int running_time, int priority, int cores)
+{
+    return scheduler_new_gang_row(jobtable_add(&ownJobs, job_number, time, running_time, priority, cores), time);
+}
+
+/**
+  Called instead of scheduler_new_gang_job() when the job is in the job table
+  given to scheduler_set_job_table().
+  @param row the job's row in the table.
+  @param time the current time of the simulator.
+  @return the lowest of the cores the job is running on
+  @return -1 if the job is waiting.
+ */
+int scheduler_new_gang_row(int row, int time)
+{
+    job_t *temp = job_new(row, time);
+
+    gangScheduling = 1;
+    stats_advance(time);
+    queue_offer(temp);
+    gang_dispatch(time);
+
+    return temp->core;
+}
+
+/**
+  Returns the job running on a core.
+  @param core_id the zero-based index of the core.
+  @return job_number of the job running on core core_id
+  @return -1 if the core is idle.
+ */
+int scheduler_core_job(int core_id)
+{
+    return coreArr[core_id] != NULL ? job_id(coreArr[core_id]) : -1;
+}
+
+/**
+  Returns the row, in the job table, of the job running on a core.
+  @param core_id the zero-based index of the core.
+  @return the row of the job running on core core_id
+  @return -1 if the core is idle.
+ */
+int scheduler_core_row(int core_id)
+{
+    return coreArr[core_id] != NULL ? coreArr[core_id]->row : -1;
+}
+
+/**
+  Called when a job has completed execution.
+-
+  The core_id, job_number and time parameters are provided for convenience. You may be able to calculate the values with your own data structure.
+  If any job should be scheduled to run on the core free'd up by the
+  finished job, return the job_number of the job that should be scheduled to
+  run on core core_id.
+-
+  @param core_id the zero-based index of the core where the job was located.
+  @param job_number a globally unique identification number of the job.
+  @param time the current time of the simulator.
+  @return job_number of the job that should be scheduled to run on core core_id
+  @return -1 if core should remain idle.
+ */
+int scheduler_job_finished(int core_id, int job_number, int time) {
+    stats_advance(time);
+    //printf("\n\n\nRESPONSE TIME JOB %d is %d\n\n\n", coreArr[core_id]->pid, coreArr[core_id]->responseTime);
+    totalResponseTime += coreArr[core_id]->responseTime;
+    if(quantumLatency > 0)
+        burst_observed(coreArr[core_id], time);
+    //at equal speeds a job is on a core for exactly its running time
+    int wait;
+    if(coreSpeed != NULL)
+        wait = time - job_arrival(coreArr[core_id]) - coreArr[core_id]->servedTime - (time - coreArr[core_id]->dispatchTime) - coreArr[core_id]->blockedTime;
+    else
+        wait = time - job_arrival(coreArr[core_id]) - job_running(coreArr[core_id]) - coreArr[core_id]->blockedTime;
+    totalWaitingTime += wait;
+    wait_class_add(job_priority(coreArr[core_id]), wait);
+    totalTATime +=time - job_arrival(coreArr[core_id]);
+    numOfJobs++;
+    if(gangScheduling)
+    {
+        //free every core of the gang, then start whatever now fits
+        job_t *job = coreArr[core_id];
+        for(int i = 0; i < numCores; i++)
+            if(coreArr[i] == job)
+                core_assign(i, NULL);
+        job_free(job);
+        gang_dispatch(time);
+        return scheduler_core_job(core_id);
+    }
+    job_free(coreArr[core_id]);
+    core_assign(core_id, NULL);
+    return dispatch_next(core_id, time);
+}
+
+/**
+  When the scheme is set to RR, called when the quantum timer has expired
+  on a core.
+-
+  If any job should be scheduled to run on the core free'd up by
+  the quantum expiration, return the job_number of the job that should be
+  scheduled to run on core core_id.
+-
+  @param core_id the zero-based index of the core where the quantum has expired.
+  @param time the current time of the simulator.
+  @return job_number of the job that should be scheduled on core cord_id
+  @return -1 if core should remain idle
+ */
+int scheduler_quantum_expired(int core_id, int time)
+{
+    stats_advance(time);
+    //only on the one core
+    //job on the core
+    job_t *temp = coreArr[core_id];
+    //if there's no job currently running on the core
+    if(temp == NULL) {
+        //if there's no job waiting in the queue
+        if(priqueue_size(&q) == 0){
+            return -1;
+        }
+    } else {
+        //otherwise put temp in the back of the queue
+        job_descheduled(temp, core_id, time);
+        queue_offer(temp);
+    }
+    //get the next job on the queue to begin running on the core
+    core_assign(core_id, queue_poll());
+    coreArr[core_id]->dispatchTime = time;
+    //nobody else was waiting, so the same job got its core straight back
+    STATS(if(coreArr[core_id] == temp) schedStats.requeues++);
+    //if job hasn't yet been run
+    if(coreArr[core_id]->responseTime == -1){
+        //response = current time - arrival time
+        coreArr[core_id]->responseTime = time - job_arrival(coreArr[core_id]);
+    }
+    return job_id(coreArr[core_id]);
+}
+
+/* Adds a job to the blocked jobs, noting its slot under its row. */
+static void blocked_add(job_t *job)
+{
+    if(numBlocked == blockedCap)
+    {
+        blockedCap = blockedCap > 0 ? blockedCap * 2 : 16;
+        blockedJobs = realloc(blockedJobs, blockedCap * sizeof(job_t *));
+    }
+    if(job->row >= blockedSlotCap)
+    {
+        int cap = blockedSlotCap > 0 ? blockedSlotCap * 2 : 16;
+        while(cap <= job->row)
+            cap *= 2;
+        blockedSlot = realloc(blockedSlot, cap * sizeof(int));
+        memset(blockedSlot + blockedSlotCap, 0, (cap - blockedSlotCap) * sizeof(int));
+        blockedSlotCap = cap;
+    }
+    blockedSlot[job->row] = numBlocked;
+    blockedJobs[numBlocked++] = job;
+}
+
+/**
+  Called when the job running on a core starts waiting for I/O. The job leaves
+  its core until scheduler_job_woke() is called for it.
+  @param core_id the zero-based index of the core the job was running on.
+  @param job_number a globally unique identification number of the job.
+  @param time the current time of the simulator.
+  @return job_number of the job that should be scheduled to run on core core_id
+  @return -1 if core should remain idle.
+ */
+int scheduler_job_blocked(int core_id, int job_number, int time)
+{
+    job_t *job = coreArr[core_id];
+
+    stats_advance(time);
+
+    if(quantumLatency > 0)
+        burst_observed(job, time);
+    if(schedScheme == PSJF)
+        job_worked(job, core_id, time - job->lastScheduled);
+    job_descheduled(job, core_id, time);
+    job->blockedTime -= time;
+
+    blocked_add(job);
+
+    core_assign(core_id, NULL);
+    return dispatch_next(core_id, time);
+}
+
+/**
+  Called when a job blocked on I/O is ready to run again. It is scheduled like a
+  new arrival, keeping its original arrival time and what is left of its running
+  time, so it may preempt under PSJF and PPRI.
+  @param job_number the job, which must have been passed to scheduler_job_blocked().
+  @param time the current time of the simulator.
+  @return index of core job should be scheduled on
+  @return -1 if no scheduling changes should be made, or the job is not blocked.
+ */
+int scheduler_job_woke(int job_number, int time)
+{
+    for(int i = 0; i < numBlocked; i++)
+        if(job_id(blockedJobs[i]) == job_number)
+            return scheduler_job_woke_row(blockedJobs[i]->row, time);
+    return -1;
+}
+
+/**
+  Called instead of scheduler_job_woke() when the job is in the job table given
+  to scheduler_set_job_table(), so the job is found by its row without a search.
+  @param row the row of the job, which must have been passed to scheduler_job_blocked().
+  @param time the current time of the simulator.
+  @return index of core job should be scheduled on
+  @return -1 if no scheduling changes should be made, or the job is not blocked.
+ */
+int scheduler_job_woke_row(int row, int time)
+{
+    if(row < 0 || row >= blockedSlotCap)
+        return -1;
+    int i = blockedSlot[row];
+    if(i >= numBlocked || blockedJobs[i]->row != row)
+        return -1;
+
+    job_t *job = blockedJobs[i];
+    blockedJobs[i] = blockedJobs[--numBlocked];
+    blockedSlot[blockedJobs[i]->row] = i;
+
+    job->blockedTime += time;
+    job->dispatchTime = time;
+
+    stats_advance(time);
+
+    //the placement sets the response time of a job it puts on a core, but this one has already had its first response
+    int responseTime = job->responseTime;
+    int core = job_placed(job, time);
+    if(responseTime != -1)
+        job->responseTime = responseTime;
+
+    return core;
+}
+
+/**
+  Returns the average waiting time of all jobs scheduled by your scheduler.
+  Assumptions:
+    - This function will only be called after all scheduling is complete (all jobs that have arrived will have finished and no new jobs will arrive).
+  @return the average waiting time of all jobs scheduled.
+ */
+float scheduler_average_waiting_time()
+{
+	return totalWaitingTime / numOfJobs;
+}
+
+/**
+  Returns the average turnaround time of all jobs scheduled by your scheduler.
+  Assumptions:
+    - This function will only be called after all scheduling is complete (all jobs that have arrived will have finished and no new jobs will arrive).
+  @return the average turnaround time of all jobs scheduled.
+ */
+float scheduler_average_turnaround_time()
+{
+	return totalTATime/numOfJobs;
+}
+
+/**
+  Returns the average response time of all jobs scheduled by your scheduler.
+  Assumptions:
+    - This function will only be called after all scheduling is complete (all jobs that have arrived will have finished and no new jobs will arrive).
+  @return the average response time of all jobs scheduled.
+ */
+float scheduler_average_response_time()
+{
+    return (totalResponseTime / numOfJobs);
+}
+
+/**
+  Under RR with an adaptive quantum (see scheduler_set_quantum_target()), returns
+  the quantum of the job on a core. Call it right after the job was put on the
+  core, as it depends on how many jobs want a core at that moment: the target
+  latency is shared out between the queued and the running jobs. When the recent
+  bursts ran a little longer than that share, up to twice as long, the quantum is
+  stretched to the average burst, so a typical burst ends by itself rather than
+  being cut short just before its end and queued again. Either way the quantum
+  stays within its bounds.
+  @param core_id the zero-based index of the core.
+  @return the quantum, in time units
+  @return 0 if the quantum is fixed, or the core is idle
+ */
+int scheduler_core_quantum(int core_id)
+{
+    if(quantumLatency == 0 || coreArr[core_id] == NULL)
+        return 0;
+
+    int runnable = priqueue_size(&q) + numCores - numIdle;
+
+    int quantum = quantumLatency / runnable;
+    int burst = (int)burstAverage;
+    if(burst < burstAverage)
+        burst++;
+    if(burst > quantum && burst <= 2 * quantum)
+        quantum = burst;
+
+    if(quantum < quantumMin)
+        quantum = quantumMin;
+    if(quantum > quantumMax)
+        quantum = quantumMax;
+    return quantum;
+}
+
+/**
+  Returns the waiting time of the jobs finished so far, for each priority any of
+  them had, so starvation of the low priorities shows up.
+  @param classes filled in with one class per priority, from the highest priority
+  (lowest value) down.
+  @param max the room in classes.
+  @return the number of classes filled in, at most max
+ */
+int scheduler_wait_classes(scheduler_wait_class_t *classes, int max)
+{
+    int count = numWaitClasses < max ? numWaitClasses : max;
+
+    for(int i = 0; i < count; i++)
+        classes[i] = waitClasses[i];
+    return count;
+}
+
+/**
+  Free any memory associated with your scheduler.
+  Assumptions:
+    - This function will be the last function called in your library.
+*/
+void scheduler_clean_up()
+{
+  //TODO: Liia do this
+  //Free every job record, along with any jobs still running, waiting or blocked (only left over when a run is cut short)
+  priqueue_destroy(&q);
+  for(int i = 0; i < numJobChunks; i++)
+    free(jobChunks[i]);
+  free(jobChunks);
+  jobChunks = NULL;
+  numJobChunks = 0;
+  jobChunkCap = 0;
+  freeJobs = NULL;
+  free(blockedJobs);
+  blockedJobs = NULL;
+  free(blockedSlot);
+  blockedSlot = NULL;
+  free(shedRows);
+  shedRows = NULL;
+  free(waitClasses);
+  waitClasses = NULL;
+  free(idleMask);
+  idleMask = NULL;
+  numWaitClasses = 0;
+  waitClassCap = 0;
+  numShed = 0;
+  shedCap = 0;
+  numBlocked = 0;
+  blockedCap = 0;
+  blockedSlotCap = 0;
+  //Free the core array
+  free(coreArr);
+  free(coreSpeed);
+  coreSpeed = NULL;
+  free(coreRate);
+  coreRate = NULL;
+  jobtable_destroy(&ownJobs);
+  jobTable = NULL;
+#ifdef SCHEDULER_STATS
+  free(coreBusy);
+  free(coreIdle);
+#endif
+  numCores = 0;
+}
+
+/**
+  Fills in the scheduler's internal counters.
+  Assumptions:
+    - The per core arrays in stats stay valid until scheduler_clean_up() is called.
+  @param stats the structure to fill in.
+  @return 1 if the counters were filled in
+  @return 0 if the scheduler was built without SCHEDULER_STATS, stats is zeroed
+*/
+int scheduler_get_stats(scheduler_stats_t *stats)
+{
+#ifdef SCHEDULER_STATS
+    *stats = schedStats;
+    stats->comparisons = q.mcomparisons;
+    stats->avg_queue_length = statsTime > 0 ? queueArea / statsTime : 0.0;
+    stats->cores = numCores;
+    stats->core_busy = coreBusy;
+    stats->core_idle = coreIdle;
+    return 1;
+#else
+    memset(stats, 0, sizeof(scheduler_stats_t));
+    return 0;
+#endif
+}
+
+/*
+  A copy of everything the scheduler knows at one point in time: the jobs on the
+  cores, the jobs in the queue (front to back), the jobs blocked on I/O and the
+  accumulators behind the averages, the placement ones included. The records keep their rows: in the caller's
+  job table, which the caller saves along, or in a copy of the scheduler's own.
+  The internal counters (SCHEDULER_STATS) are not part of it.
+*/
+struct _scheduler_snapshot_t
+{
+    int time;
+    scheme_t scheme;
+    int cores;
+    float totalWaitingTime;
+    float totalResponseTime;
+    float totalTATime;
+    int numOfJobs;
+    int queued; //number of entries in queue
+    int blocked; //number of blocked jobs, kept in queue after the queued ones
+    int gangScheduling; //1 if coreJobs holds a gang job once for each of its cores
+    int aging; //the aging interval, 0 if off
+    int quantumLatency, quantumMin, quantumMax; //the adaptive quantum, latency 0 if fixed
+    double burstAverage;
+    long seenJobs; //the totals idle_core_as() measures arriving jobs against
+    double seenRunningTime, seenPriority;
+    int waitClasses; //number of entries in classes
+    scheduler_wait_class_t *classes;
+    int *running; //per core, 1 if coreJobs holds the job running on it
+    job_t *coreJobs;
+    job_t *queue;
+    int shared; //1 if the jobs are in the caller's table (see scheduler_set_job_table()), 0 if ownJobs is copied into jobs
+    jobtable_t jobs;
+};
+
+static scheduler_snapshot_t *snapshot_alloc(int cores, int queued, int blocked, int classes)
+{
+    scheduler_snapshot_t *snapshot = malloc(sizeof(scheduler_snapshot_t));
+    if(snapshot == NULL)
+        return NULL;
+    snapshot->cores = cores;
+    snapshot->queued = queued;
+    snapshot->blocked = blocked;
+    snapshot->waitClasses = classes;
+    snapshot->shared = 1;
+    memset(&snapshot->jobs, 0, sizeof(jobtable_t));
+    snapshot->running = calloc(cores, sizeof(int));
+    snapshot->coreJobs = calloc(cores, sizeof(job_t));
+    snapshot->queue = malloc((queued + blocked > 0 ? queued + blocked : 1) * sizeof(job_t));
+    snapshot->classes = malloc((classes > 0 ? classes : 1) * sizeof(scheduler_wait_class_t));
+    if(snapshot->running == NULL || snapshot->coreJobs == NULL || snapshot->queue == NULL || snapshot->classes == NULL)
+    {
+        scheduler_snapshot_free(snapshot);
+        return NULL;
+    }
+    return snapshot;
+}
+
+/**
+  Takes a snapshot of the scheduler's state. The scheduler itself is not changed
+  and carries on as normal.
+  @param time the current time of the simulator.
+  @return the snapshot, to be released with scheduler_snapshot_free()
+  @return NULL if out of memory
+ */
+scheduler_snapshot_t *scheduler_snapshot(int time)
+{
+    scheduler_snapshot_t *snapshot = snapshot_alloc(numCores, priqueue_size(&q), numBlocked, numWaitClasses);
+    if(snapshot == NULL)
+        return NULL;
+
+    snapshot->time = time;
+    snapshot->scheme = schedScheme;
+    snapshot->totalWaitingTime = totalWaitingTime;
+    snapshot->totalResponseTime = totalResponseTime;
+    snapshot->totalTATime = totalTATime;
+    snapshot->numOfJobs = numOfJobs;
+    snapshot->gangScheduling = gangScheduling;
+    snapshot->aging = agingScale != AGING_OFF ? (int)agingScale : 0;
+    snapshot->quantumLatency = quantumLatency;
+    snapshot->quantumMin = quantumMin;
+    snapshot->quantumMax = quantumMax;
+    snapshot->burstAverage = burstAverage;
+    snapshot->seenJobs = seenJobs;
+    snapshot->seenRunningTime = seenRunningTime;
+    snapshot->seenPriority = seenPriority;
+    scheduler_wait_classes(snapshot->classes, numWaitClasses);
+    if(jobTable == &ownJobs)
+    {
+        snapshot->shared = 0;
+        if(!jobtable_init(&snapshot->jobs, ownJobs.mcount) || !jobtable_copy(&snapshot->jobs, &ownJobs))
+        {
+            scheduler_snapshot_free(snapshot);
+            return NULL;
+        }
+    }
+
+    for(int i = 0; i < numCores; i++)
+    {
+        if(coreArr[i] != NULL)
+        {
+            snapshot->running[i] = 1;
+            snapshot->coreJobs[i] = *coreArr[i];
+        }
+    }
+
+    priqueue_iter_t it;
+    priqueue_iter_begin(&q, &it);
+    for(int i = 0; i < snapshot->queued; i++)
+        snapshot->queue[i] = *(job_t *)priqueue_iter_next(&it);
+    for(int i = 0; i < numBlocked; i++)
+        snapshot->queue[snapshot->queued + i] = *blockedJobs[i];
+
+    return snapshot;
+}
+
+/**
+  Replaces the scheduler's state with a copy of a snapshot, so the simulation can
+  carry on from the time it was taken. The snapshot is left untouched and can be
+  restored any number of times.
+  May be called instead of scheduler_start_up(), or at any point after it, in
+  which case the current state is thrown away first.
+  The scheme may differ from the one the snapshot was taken under: the queue is
+  then reordered for the new scheme, with ties keeping their old order. Jobs
+  already on a core keep it until the new scheme's next decision.
+  @param snapshot the snapshot to restore.
+  @param scheme the scheme to carry on with.
+  @param jobs when the snapshot was taken with a job table (see
+  scheduler_set_job_table()), that table as it was then, or a copy of it, to
+  work on from now; otherwise NULL.
+ */
+void scheduler_restore(scheduler_snapshot_t *snapshot, scheme_t scheme, const jobtable_t *jobs)
+{
+    int time = snapshot->time;
+
+    if(numCores > 0)
+        scheduler_clean_up();
+    scheduler_start_up(snapshot->cores, scheme);
+
+    totalWaitingTime = snapshot->totalWaitingTime;
+    totalResponseTime = snapshot->totalResponseTime;
+    totalTATime = snapshot->totalTATime;
+    numOfJobs = snapshot->numOfJobs;
+    gangScheduling = snapshot->gangScheduling;
+    if(snapshot->aging > 0)
+        agingScale = snapshot->aging;
+    quantumLatency = snapshot->quantumLatency;
+    quantumMin = snapshot->quantumMin;
+    quantumMax = snapshot->quantumMax;
+    burstAverage = snapshot->burstAverage;
+    seenJobs = snapshot->seenJobs;
+    seenRunningTime = snapshot->seenRunningTime;
+    seenPriority = snapshot->seenPriority;
+    if(snapshot->shared)
+        jobTable = jobs;
+    else
+        jobtable_copy(&ownJobs, &snapshot->jobs);
+    if(snapshot->waitClasses > 0)
+    {
+        waitClassCap = snapshot->waitClasses;
+        waitClasses = malloc(waitClassCap * sizeof(scheduler_wait_class_t));
+        memcpy(waitClasses, snapshot->classes, waitClassCap * sizeof(scheduler_wait_class_t));
+        numWaitClasses = waitClassCap;
+    }
+#ifdef SCHEDULER_STATS
+    statsTime = time;
+#endif
+
+    for(int i = 0; i < numCores; i++)
+    {
+        if(!snapshot->running[i])
+            continue;
+        //the other cores of a gang share the job of its lowest core
+        if(gangScheduling && snapshot->coreJobs[i].core != i)
+        {
+            core_assign(i, coreArr[snapshot->coreJobs[i].core]);
+            continue;
+        }
+        job_t *job = job_alloc();
+        *job = snapshot->coreJobs[i];
+        if(scheme != snapshot->scheme)
+        {
+            //bring the remaining time of the running job up to now, the way its old scheme tracked it
+            if(snapshot->scheme == PSJF)
+                job_worked(job, i, time - job->lastScheduled);
+            else
+                job_worked(job, i, time - job->dispatchTime);
+            job->servedTime += time - job->dispatchTime;
+            job->dispatchTime = time;
+            if(scheme == PSJF)
+                job->lastScheduled = time;
+        }
+        core_assign(i, job);
+    }
+
+    for(int i = 0; i < snapshot->queued; i++)
+    {
+        job_t *job = job_alloc();
+        *job = snapshot->queue[i];
+        priqueue_offer_keyed(&q, job, job_key(job));
+    }
+
+    if(snapshot->blocked > 0)
+    {
+        for(int i = 0; i < snapshot->blocked; i++)
+        {
+            job_t *job = job_alloc();
+            *job = snapshot->queue[snapshot->queued + i];
+            blocked_add(job);
+        }
+    }
+}
+
+/**
+  Writes a snapshot to a file, in the machine's own binary layout.
+  @param snapshot the snapshot to write.
+  @param file an open file to write it to.
+  @return 1 on success, 0 if writing failed
+ */
+int scheduler_snapshot_write(scheduler_snapshot_t *snapshot, FILE *file)
+{
+    int header[] = { snapshot->time, snapshot->scheme, snapshot->cores, snapshot->numOfJobs, snapshot->queued, snapshot->blocked,
+                     snapshot->gangScheduling, snapshot->aging, snapshot->waitClasses,
+                     snapshot->quantumLatency, snapshot->quantumMin, snapshot->quantumMax, snapshot->shared };
+    float totals[] = { snapshot->totalWaitingTime, snapshot->totalResponseTime, snapshot->totalTATime };
+    double averages[] = { snapshot->burstAverage, snapshot->seenRunningTime, snapshot->seenPriority };
+    int n = snapshot->cores, m = snapshot->queued + snapshot->blocked;
+
+    return fwrite(header, sizeof(header), 1, file) == 1 &&
+           fwrite(totals, sizeof(totals), 1, file) == 1 &&
+           fwrite(averages, sizeof(averages), 1, file) == 1 &&
+           fwrite(&snapshot->seenJobs, sizeof(long), 1, file) == 1 &&
+           fwrite(snapshot->running, sizeof(int), n, file) == (size_t)n &&
+           fwrite(snapshot->coreJobs, sizeof(job_t), n, file) == (size_t)n &&
+           fwrite(snapshot->queue, sizeof(job_t), m, file) == (size_t)m &&
+           fwrite(snapshot->classes, sizeof(scheduler_wait_class_t), snapshot->waitClasses, file) == (size_t)snapshot->waitClasses &&
+           (snapshot->shared || jobtable_write(&snapshot->jobs, file));
+}
+
+/**
+  Reads a snapshot written by scheduler_snapshot_write().
+  @param file an open file to read it from.
+  @return the snapshot, to be released with scheduler_snapshot_free()
+  @return NULL if the file is truncated or corrupt, or out of memory
+ */
+scheduler_snapshot_t *scheduler_snapshot_read(FILE *file)
+{
+    int header[13];
+    float totals[3];
+    double averages[3];
+    long seen;
+
+    if(fread(header, sizeof(header), 1, file) != 1 || fread(totals, sizeof(totals), 1, file) != 1 ||
+       fread(averages, sizeof(averages), 1, file) != 1 || fread(&seen, sizeof(seen), 1, file) != 1)
+        return NULL;
+    if(seen < 0 || header[1] < FCFS || header[1] > RR || header[2] <= 0 || header[4] < 0 || header[5] < 0 || header[7] < 0 || header[8] < 0 ||
+       header[9] < 0 || (header[9] > 0 && (header[10] <= 0 || header[11] < header[10])))
+        return NULL;
+
+    scheduler_snapshot_t *snapshot = snapshot_alloc(header[2], header[4], header[5], header[8]);
+    if(snapshot == NULL)
+        return NULL;
+
+    snapshot->time = header[0];
+    snapshot->scheme = header[1];
+    snapshot->numOfJobs = header[3];
+    snapshot->gangScheduling = header[6];
+    snapshot->aging = header[7];
+    snapshot->quantumLatency = header[9];
+    snapshot->quantumMin = header[10];
+    snapshot->quantumMax = header[11];
+    snapshot->shared = header[12] != 0;
+    snapshot->burstAverage = averages[0];
+    snapshot->seenRunningTime = averages[1];
+    snapshot->seenPriority = averages[2];
+    snapshot->seenJobs = seen;
+    snapshot->totalWaitingTime = totals[0];
+    snapshot->totalResponseTime = totals[1];
+    snapshot->totalTATime = totals[2];
+
+    int n = snapshot->cores, m = snapshot->queued + snapshot->blocked;
+    if(fread(snapshot->running, sizeof(int), n, file) != (size_t)n ||
+       fread(snapshot->coreJobs, sizeof(job_t), n, file) != (size_t)n ||
+       fread(snapshot->queue, sizeof(job_t), m, file) != (size_t)m ||
+       fread(snapshot->classes, sizeof(scheduler_wait_class_t), snapshot->waitClasses, file) != (size_t)snapshot->waitClasses ||
+       (!snapshot->shared && !jobtable_read(&snapshot->jobs, file)))
+    {
+        scheduler_snapshot_free(snapshot);
+        return NULL;
+    }
+    for(int i = 0; snapshot->gangScheduling && i < n; i++)
+    {
+        int lead = snapshot->coreJobs[i].core;
+        if(snapshot->running[i] && (lead < 0 || lead > i || !snapshot->running[lead]))
+        {
+            scheduler_snapshot_free(snapshot);
+            return NULL;
+        }
+    }
+    return snapshot;
+}
+
+/**
+  Returns the time a snapshot was taken at.
+  @param snapshot the snapshot.
+  @return the time passed to scheduler_snapshot()
+ */
+int scheduler_snapshot_time(scheduler_snapshot_t *snapshot)
+{
+    return snapshot->time;
+}
+
+/**
+  Frees a snapshot.
+  @param snapshot the snapshot, may be NULL.
+ */
+void scheduler_snapshot_free(scheduler_snapshot_t *snapshot)
+{
+    if(snapshot == NULL)
+        return;
+    free(snapshot->running);
+    free(snapshot->coreJobs);
+    free(snapshot->queue);
+    free(snapshot->classes);
+    jobtable_destroy(&snapshot->jobs);
+    free(snapshot);
+}
+
+/**
+  This function may print out any debugging information you choose. This
+  function will be called by the simulator after every call the simulator
+  makes to your scheduler.
+  In our provided output, we have implemented this function to list the jobs in the order they are to be scheduled. Furthermore, we have also listed the current state of the job (either running on a given core or idle). For example, if we have a non-preemptive algorithm and job(id=4) has began running, job(id=2) arrives with a higher priority, and job(id=1) arrives with a lower priority, the output in our sample output will be:
+    2(-1) 4(0) 1(-1)
+  This function is not required and will not be graded. You may leave it
+  blank if you do not find it useful.
+ */
+void scheduler_show_queue()
+{
+  //TODO: Liia do this
+  priqueue_iter_t it;
+  job_t* valptr;
+  priqueue_iter_begin(&q, &it);
+  while((valptr = (job_t*)priqueue_iter_next(&it)) != NULL)
+  {
+    //print job and the core that its running on
+    printf("   %d (%d) ", job_id(valptr), valptr->core);
+  }
+}
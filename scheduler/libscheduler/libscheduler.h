@@ -1,23 +1,108 @@
-/** @file libscheduler.h
- */
-
-#ifndef LIBSCHEDULER_H_
-#define LIBSCHEDULER_H_
-
-/**
-  Constants which represent the different scheduling algorithms
-*/
-typedef enum {FCFS = 0, SJF, PSJF, PRI, PPRI, RR} scheme_t;
-
-void  scheduler_start_up               (int cores, scheme_t scheme);
-int   scheduler_new_job                (int job_number, int time, int running_time, int priority);
-int   scheduler_job_finished           (int core_id, int job_number, int time);
-int   scheduler_quantum_expired        (int core_id, int time);
-float scheduler_average_turnaround_time();
-float scheduler_average_waiting_time   ();
-float scheduler_average_response_time  ();
-void  scheduler_clean_up               ();
-
-void  scheduler_show_queue             ();
-
-#endif /* LIBSCHEDULER_H_ */
+/** @file libscheduler.h
+ */
+
+#ifndef LIBSCHEDULER_H_
+#define LIBSCHEDULER_H_
+
+#include <stdio.h>
+
+#include "../libjobtable/libjobtable.h"
+
+/**
+  Constants which represent the different scheduling algorithms
+*/
+typedef enum {FCFS = 0, SJF, PSJF, PRI, PPRI, RR} scheme_t;
+
+/**
+  Constants which represent what happens to an arriving job when the run queue is
+  full, see scheduler_set_admission()
+*/
+typedef enum {ADMIT_ALL = 0, ADMIT_REJECT_NEWEST, ADMIT_DROP_LOWEST, ADMIT_DEADLINE} admission_t;
+
+/**
+  Returned by scheduler_new_job() for a job that was not admitted
+*/
+#define SCHEDULER_REJECTED -2
+
+/**
+  A job arriving as part of a batch, see scheduler_new_jobs()
+*/
+typedef struct _scheduler_arrival_t
+{
+    int job_number; //a globally unique identification number of the job
+    int running_time; //the total number of time units the job will run
+    int priority; //the priority of the job (the lower the value, the higher the priority)
+    int core; //set by the scheduler: core the job is running on, -1 if it is waiting, SCHEDULER_REJECTED if it was not admitted
+    int row; //the job's row in the job table given to scheduler_set_job_table(), set by the scheduler when it keeps its own
+} scheduler_arrival_t;
+
+/**
+  The waiting time of the finished jobs of one priority, see scheduler_wait_classes()
+*/
+typedef struct _scheduler_wait_class_t
+{
+    int priority; //the priority of the jobs
+    int jobs; //the number of them that finished
+    int max_wait; //the longest any of them waited
+    double total_wait; //their waiting times added up
+} scheduler_wait_class_t;
+
+/**
+  Internal counters of the scheduler, see scheduler_get_stats()
+*/
+typedef struct _scheduler_stats_t
+{
+    long comparisons; //key comparisons made by the run queue
+    long offers; //jobs offered to the run queue
+    long polls; //jobs polled from the run queue
+    long preemptions; //running jobs sent back to the queue by an arriving job
+    long requeues; //quantum expiries that gave the core straight back to the same job
+    long backfills; //jobs started ahead of a waiting gang without delaying it (gang scheduling)
+    int max_queue_depth; //high-water mark of the run queue length
+    double avg_queue_length; //time weighted average of the run queue length
+    int cores; //number of entries in core_busy and core_idle
+    const long *core_busy; //per core time units spent running a job
+    const long *core_idle; //per core time units spent idle
+} scheduler_stats_t;
+
+/**
+  A saved copy of the scheduler's state, see scheduler_snapshot()
+*/
+typedef struct _scheduler_snapshot_t scheduler_snapshot_t;
+
+void  scheduler_start_up               (int cores, scheme_t scheme);
+void  scheduler_set_job_table          (const jobtable_t *jobs);
+void  scheduler_set_core_speeds        (const double *speeds);
+void  scheduler_set_admission          (int max_queue, admission_t policy, int deadline);
+void  scheduler_set_aging              (int interval);
+void  scheduler_set_quantum_target     (int latency, int min_quantum, int max_quantum);
+int   scheduler_shed_jobs              (const int **rows);
+int   scheduler_new_job                (int job_number, int time, int running_time, int priority);
+int   scheduler_new_jobs               (scheduler_arrival_t *jobs, int count, int time);
+int   scheduler_job_finished           (int core_id, int job_number, int time);
+int   scheduler_quantum_expired        (int core_id, int time);
+int   scheduler_job_blocked            (int core_id, int job_number, int time);
+int   scheduler_job_woke               (int job_number, int time);
+int   scheduler_job_woke_row           (int row, int time);
+int   scheduler_new_gang_job           (int job_number, int time, int running_time, int priority, int cores);
+int   scheduler_new_gang_row           (int row, int time);
+int   scheduler_core_job               (int core_id);
+int   scheduler_core_row               (int core_id);
+int   scheduler_core_quantum           (int core_id);
+float scheduler_average_turnaround_time();
+float scheduler_average_waiting_time   ();
+float scheduler_average_response_time  ();
+int   scheduler_wait_classes           (scheduler_wait_class_t *classes, int max);
+void  scheduler_clean_up               ();
+
+void  scheduler_show_queue             ();
+int   scheduler_get_stats              (scheduler_stats_t *stats);
+
+scheduler_snapshot_t *scheduler_snapshot      (int time);
+void                  scheduler_restore       (scheduler_snapshot_t *snapshot, scheme_t scheme, const jobtable_t *jobs);
+int                   scheduler_snapshot_write(scheduler_snapshot_t *snapshot, FILE *file);
+scheduler_snapshot_t *scheduler_snapshot_read (FILE *file);
+int                   scheduler_snapshot_time (scheduler_snapshot_t *snapshot);
+void                  scheduler_snapshot_free (scheduler_snapshot_t *snapshot);
+
+#endif /* LIBSCHEDULER_H_ */
@@ -0,0 +1,242 @@
+/** @file libtimerwheel.c
+ */
+
+#include <stdlib.h>
+
+#include "libtimerwheel.h"
+
+#define TIMERWHEEL_MASK (TIMERWHEEL_SLOTS - 1)
+#define TIMERWHEEL_OVERFLOW (TIMERWHEEL_LEVELS * TIMERWHEEL_SLOTS)
+#define TIMERWHEEL_DUE (TIMERWHEEL_OVERFLOW + 1)
+
+
+static void timerwheel_link(timerwheel_t *w, int timer, int list)
+{
+    int head = w->mheads[list];
+
+    w->mlist[timer] = list;
+    w->mprev[timer] = -1;
+    w->mnext[timer] = head;
+    if(head != -1)
+        w->mprev[head] = timer;
+    w->mheads[list] = timer;
+}
+
+static void timerwheel_unlink(timerwheel_t *w, int timer)
+{
+    int prev = w->mprev[timer], next = w->mnext[timer];
+
+    if(prev != -1)
+        w->mnext[prev] = next;
+    else
+        w->mheads[w->mlist[timer]] = next;
+    if(next != -1)
+        w->mprev[next] = prev;
+}
+
+/*
+  Files an armed timer under the lowest level whose slot span holds both the
+  current time and its expiry
+*/
+static void timerwheel_place(timerwheel_t *w, int timer)
+{
+    int expiry = w->mexpiry[timer];
+
+    if(expiry <= w->mnow)
+    {
+        timerwheel_link(w, timer, TIMERWHEEL_DUE);
+        return;
+    }
+
+    for(int level = 0; level < TIMERWHEEL_LEVELS; level++)
+    {
+        int shift = TIMERWHEEL_BITS * (level + 1);
+
+        if((expiry >> shift) == (w->mnow >> shift))
+        {
+            timerwheel_link(w, timer, level * TIMERWHEEL_SLOTS + ((expiry >> (shift - TIMERWHEEL_BITS)) & TIMERWHEEL_MASK));
+            return;
+        }
+    }
+
+    timerwheel_link(w, timer, TIMERWHEEL_OVERFLOW);
+}
+
+/*
+  Empties a list, filing its timers again against the current time. Those that
+  expire now go in the level 0 slot about to be taken.
+*/
+static void timerwheel_cascade(timerwheel_t *w, int list)
+{
+    int timer = w->mheads[list];
+
+    w->mheads[list] = -1;
+    while(timer != -1)
+    {
+        int next = w->mnext[timer];
+
+        if(w->mexpiry[timer] == w->mnow)
+            timerwheel_link(w, timer, w->mnow & TIMERWHEEL_MASK);
+        else
+            timerwheel_place(w, timer);
+        timer = next;
+    }
+}
+
+/*
+  Moves every timer in a list to expired, making them idle
+*/
+static int timerwheel_take(timerwheel_t *w, int list, int *expired)
+{
+    int timer = w->mheads[list], count = 0;
+
+    w->mheads[list] = -1;
+    while(timer != -1)
+    {
+        expired[count++] = timer;
+        w->mexpiry[timer] = -1;
+        timer = w->mnext[timer];
+    }
+
+    return count;
+}
+
+
+/**
+  Initializes the timerwheel_t data structure, with every timer idle.
+
+  @param w a pointer to an instance of the timerwheel_t data structure
+  @param timers the number of timers
+  @param now the time up to which timers count as already expired; the first call
+         to timerwheel_expire() will normally be for now + 1
+  @return 1 on success
+  @return 0 if out of memory
+ */
+int timerwheel_init(timerwheel_t *w, int timers, int now)
+{
+    w->mcount = timers;
+    w->mexpiry = malloc(timers * sizeof(int));
+    w->mlist = malloc(timers * sizeof(int));
+    w->mnext = malloc(timers * sizeof(int));
+    w->mprev = malloc(timers * sizeof(int));
+
+    if(w->mexpiry == NULL || w->mlist == NULL || w->mnext == NULL || w->mprev == NULL)
+        return 0;
+
+    timerwheel_reset(w, now);
+    return 1;
+}
+
+
+/**
+  Makes every timer idle, and moves the wheel to a new time.
+
+  @param w a pointer to an instance of the timerwheel_t data structure
+  @param now the time up to which timers count as already expired
+ */
+void timerwheel_reset(timerwheel_t *w, int now)
+{
+    w->mnow = now;
+    for(int i = 0; i < w->mcount; i++)
+        w->mexpiry[i] = -1;
+    for(int i = 0; i < TIMERWHEEL_DUE + 1; i++)
+        w->mheads[i] = -1;
+}
+
+
+/**
+  Arms a timer, or moves it if it is already armed. A timer armed for a time that
+  has already been expired goes off on the next call to timerwheel_expire().
+
+  @param w a pointer to an instance of the timerwheel_t data structure
+  @param timer the timer
+  @param expiry the time it goes off, at least 0
+ */
+void timerwheel_set(timerwheel_t *w, int timer, int expiry)
+{
+    if(w->mexpiry[timer] != -1)
+        timerwheel_unlink(w, timer);
+
+    w->mexpiry[timer] = expiry;
+    timerwheel_place(w, timer);
+}
+
+
+/**
+  Makes a timer idle. Cancelling an idle timer does nothing.
+
+  @param w a pointer to an instance of the timerwheel_t data structure
+  @param timer the timer
+ */
+void timerwheel_cancel(timerwheel_t *w, int timer)
+{
+    if(w->mexpiry[timer] == -1)
+        return;
+
+    timerwheel_unlink(w, timer);
+    w->mexpiry[timer] = -1;
+}
+
+
+/**
+  Returns when a timer goes off.
+
+  @param w a pointer to an instance of the timerwheel_t data structure
+  @param timer the timer
+  @return its expiry
+  @return -1 if it is idle
+ */
+int timerwheel_expiry(timerwheel_t *w, int timer)
+{
+    return w->mexpiry[timer];
+}
+
+
+/**
+  Moves the wheel on to time, one tick at a time, and collects every timer that
+  goes off on the way. The timers collected are idle again.
+
+  @param w a pointer to an instance of the timerwheel_t data structure
+  @param time the time to expire up to, and including
+  @param expired filled in with the timers that went off, in no particular order;
+         it must have room for every timer
+  @return the number of timers that went off
+ */
+int timerwheel_expire(timerwheel_t *w, int time, int *expired)
+{
+    int count = timerwheel_take(w, TIMERWHEEL_DUE, expired);
+
+    while(w->mnow < time)
+    {
+        int now = ++w->mnow;
+
+        if((now & ((1 << (TIMERWHEEL_BITS * TIMERWHEEL_LEVELS)) - 1)) == 0)
+            timerwheel_cascade(w, TIMERWHEEL_OVERFLOW);
+
+        for(int level = TIMERWHEEL_LEVELS - 1; level > 0; level--)
+        {
+            int shift = TIMERWHEEL_BITS * level;
+
+            if((now & ((1 << shift) - 1)) == 0)
+                timerwheel_cascade(w, level * TIMERWHEEL_SLOTS + ((now >> shift) & TIMERWHEEL_MASK));
+        }
+
+        count += timerwheel_take(w, now & TIMERWHEEL_MASK, expired + count);
+    }
+
+    return count;
+}
+
+
+/**
+  Destroys and frees all the memory associated with w.
+
+  @param w a pointer to an instance of the timerwheel_t data structure
+ */
+void timerwheel_destroy(timerwheel_t *w)
+{
+    free(w->mexpiry);
+    free(w->mlist);
+    free(w->mnext);
+    free(w->mprev);
+}
@@ -0,0 +1,53 @@
+/** @file libtimerwheel.h
+ */
+
+#ifndef LIBTIMERWHEEL_H_
+#define LIBTIMERWHEEL_H_
+
+#define TIMERWHEEL_BITS 6
+#define TIMERWHEEL_SLOTS (1 << TIMERWHEEL_BITS)
+#define TIMERWHEEL_LEVELS 4
+
+/**
+ *  Timer Wheel Structure, a fixed set of timers numbered 0 to count - 1, each of
+ *  which is either idle or armed to go off at an absolute time.
+ *
+ *  Level l has TIMERWHEEL_SLOTS slots of TIMERWHEEL_SLOTS^l time units each, and a
+ *  timer sits in the lowest level whose slot span covers both the current time and
+ *  its expiry. Timers too far away for the top level wait in an overflow list.
+ *  As time moves on, the slot of a higher level that has just been reached is
+ *  emptied into the levels below it, so every tick only touches the timers that
+ *  expire in it, and the occasional slot being cascaded.
+ *
+ *  Member variables:
+ *      mnow = the time up to which the timers have been expired
+ *      mcount = the number of timers
+ *      mexpiry = the expiry of each timer, -1 when idle
+ *      mlist = the list each armed timer is in: level * TIMERWHEEL_SLOTS + slot for
+ *              a wheel slot, TIMERWHEEL_LEVELS * TIMERWHEEL_SLOTS for the overflow
+ *              list and one more for the timers armed for an expired time
+ *      mnext, mprev = each timer's neighbours in its list, -1 at the ends
+ *      mheads = the first timer of each list, -1 when empty: the level 0 slots,
+ *               then the slots of each higher level, then the overflow list, then
+ *               the list of timers that were armed for a time already expired
+ */
+typedef struct _timerwheel_t
+{
+    int mnow;
+    int mcount;
+    int *mexpiry;
+    int *mlist;
+    int *mnext, *mprev;
+    int mheads[TIMERWHEEL_LEVELS * TIMERWHEEL_SLOTS + 2];
+
+} timerwheel_t;
+
+int  timerwheel_init    (timerwheel_t *w, int timers, int now);
+void timerwheel_reset   (timerwheel_t *w, int now);
+void timerwheel_set     (timerwheel_t *w, int timer, int expiry);
+void timerwheel_cancel  (timerwheel_t *w, int timer);
+int  timerwheel_expiry  (timerwheel_t *w, int timer);
+int  timerwheel_expire  (timerwheel_t *w, int time, int *expired);
+void timerwheel_destroy (timerwheel_t *w);
+
+#endif /* LIBTIMERWHEEL_H_ */
@@ -0,0 +1,140 @@
+/** @file libtimeseries.c
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "libtimeseries.h"
+
+
+/*
+  The time unit right after the current window
+*/
+static int timeseries_end(timeseries_t *ts)
+{
+    return (ts->mstart / ts->mwindow + 1) * ts->mwindow;
+}
+
+/*
+  Writes the row of the current window, up to end, and starts the next one there
+*/
+static void timeseries_flush(timeseries_t *ts, int end)
+{
+    int length = end - ts->mstart;
+
+    if(ts->mok && fprintf(ts->mfile, "%d,%d,%.4f,%.3f,%d,%d,%d,%d\n", ts->mstart, end,
+                          (double)ts->mbusy / ((double)ts->mcores * length), (double)ts->mqueued / length,
+                          ts->mmaxqueue, ts->marrivals, ts->mcompletions, ts->mpreemptions) < 0)
+        ts->mok = 0;
+
+    ts->mstart = end;
+    ts->mbusy = 0;
+    ts->mqueued = 0;
+    ts->mmaxqueue = 0;
+    ts->marrivals = 0;
+    ts->mcompletions = 0;
+    ts->mpreemptions = 0;
+}
+
+/*
+  Writes every window that is over by time
+*/
+static void timeseries_advance(timeseries_t *ts, int time)
+{
+    while(time >= timeseries_end(ts))
+        timeseries_flush(ts, timeseries_end(ts));
+}
+
+
+/**
+  Creates a CSV file and writes its header line.
+
+  @param ts a pointer to an instance of the timeseries_t data structure
+  @param file_name the file to write
+  @param window the number of time units in a window, at least 1
+  @param cores the number of cores
+  @param time the first time unit to be sampled; when it is not the start of a
+         window, the first row only covers the rest of that window
+  @return 1 on success
+  @return 0 if the file could not be created
+ */
+int timeseries_open(timeseries_t *ts, const char *file_name, int window, int cores, int time)
+{
+    ts->mfile = fopen(file_name, "w");
+    if(ts->mfile == NULL)
+        return 0;
+
+    ts->mwindow = window;
+    ts->mcores = cores;
+    ts->mstart = time;
+    ts->mbusy = 0;
+    ts->mqueued = 0;
+    ts->mmaxqueue = 0;
+    ts->marrivals = 0;
+    ts->mcompletions = 0;
+    ts->mpreemptions = 0;
+    ts->mok = fprintf(ts->mfile, "\"Start\",\"End\",\"Utilisation\",\"Avg queue length\",\"Max queue length\","
+                                 "\"Arrivals\",\"Completions\",\"Preemptions\"\n") > 0;
+    return 1;
+}
+
+
+/**
+  Counts a scheduling event. Arrivals, finishes and preemptions are counted; every
+  other type is ignored.
+
+  @param ts a pointer to an instance of the timeseries_t data structure
+  @param time the time unit the event happened in, no earlier than the last one given
+  @param type the event type
+ */
+void timeseries_event(timeseries_t *ts, int time, event_type_t type)
+{
+    timeseries_advance(ts, time);
+
+    if(type == EVENT_ARRIVAL)
+        ts->marrivals++;
+    else if(type == EVENT_FINISH)
+        ts->mcompletions++;
+    else if(type == EVENT_PREEMPT)
+        ts->mpreemptions++;
+}
+
+
+/**
+  Samples the state of a time unit, once it has been run.
+
+  @param ts a pointer to an instance of the timeseries_t data structure
+  @param time the time unit, no earlier than the last one given
+  @param busy the number of cores that ran a job
+  @param queued the number of jobs that were ready to run but had no core
+ */
+void timeseries_tick(timeseries_t *ts, int time, int busy, int queued)
+{
+    timeseries_advance(ts, time);
+
+    ts->mbusy += busy;
+    ts->mqueued += queued;
+    if(queued > ts->mmaxqueue)
+        ts->mmaxqueue = queued;
+}
+
+
+/**
+  Writes the rows still due, the last one ending at time, and closes the file.
+
+  @param ts a pointer to an instance of the timeseries_t data structure
+  @param time the time unit right after the last one sampled
+  @return 1 on success
+  @return 0 if writing the file failed
+ */
+int timeseries_close(timeseries_t *ts, int time)
+{
+    timeseries_advance(ts, time);
+    if(time > ts->mstart)
+        timeseries_flush(ts, time);
+
+    int ok = (fclose(ts->mfile) == 0) && ts->mok;
+    ts->mfile = NULL;
+
+    return ok;
+}
@@ -0,0 +1,49 @@
+/** @file libtimeseries.h
+ */
+
+#ifndef LIBTIMESERIES_H_
+#define LIBTIMESERIES_H_
+
+#include <stdio.h>
+
+#include "../libeventlog/libeventlog.h"
+
+/**
+ *  Time Series Structure, aggregates a simulation into fixed windows of time units
+ *  and writes one CSV row per window as soon as the window is over, so it takes the
+ *  same memory however long the simulation runs.
+ *
+ *  Window k covers the time units [k * mwindow, (k + 1) * mwindow).
+ *
+ *  Member variables:
+ *      mfile = the open CSV file
+ *      mwindow = the number of time units in a window
+ *      mcores = the number of cores, for the utilisation
+ *      mstart = the first time unit of the current window
+ *      mbusy = core time units spent running a job in the current window
+ *      mqueued = the run queue length summed over the time units of the current window
+ *      mmaxqueue = the longest the run queue was in the current window
+ *      marrivals, mcompletions, mpreemptions = events counted in the current window
+ *      mok = 0 once writing the file failed
+ */
+typedef struct _timeseries_t
+{
+    FILE *mfile;
+    int mwindow;
+    int mcores;
+    int mstart;
+    long mbusy;
+    long mqueued;
+    int mmaxqueue;
+    int marrivals;
+    int mcompletions;
+    int mpreemptions;
+    int mok;
+} timeseries_t;
+
+int  timeseries_open  (timeseries_t *ts, const char *file_name, int window, int cores, int time);
+void timeseries_event (timeseries_t *ts, int time, event_type_t type);
+void timeseries_tick  (timeseries_t *ts, int time, int busy, int queued);
+int  timeseries_close (timeseries_t *ts, int time);
+
+#endif /* LIBTIMESERIES_H_ */
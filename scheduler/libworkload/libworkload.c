@@ -0,0 +1,418 @@
+/** @file libworkload.c
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "libworkload.h"
+
+
+/*
+  splitmix64, used to turn the user's seed into a well mixed generator state
+*/
+static unsigned long long workload_mix(unsigned long long x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/*
+  xorshift64*, returns a uniformly distributed double in the open interval (0, 1)
+*/
+static double workload_uniform(workload_t *w)
+{
+    w->mstate ^= w->mstate >> 12;
+    w->mstate ^= w->mstate << 25;
+    w->mstate ^= w->mstate >> 27;
+    unsigned long long x = w->mstate * 0x2545F4914F6CDD1DULL;
+    //53 random bits, shifted by half a step so we never return 0 (log(0) is bad news)
+    return ((x >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+static double workload_exponential(workload_t *w, double mean)
+{
+    return -mean * log(workload_uniform(w));
+}
+
+/*
+  A geometrically distributed count, at least 1, with the given mean (at least 1)
+*/
+static long workload_geometric(workload_t *w, double mean)
+{
+    if(mean <= 1.0)
+        return 1;
+    return 1 + (long)floor(log(workload_uniform(w)) / log(1.0 - 1.0 / mean));
+}
+
+/*
+  Mean of the configured running time distribution, needed to hit the target utilisation
+*/
+static double workload_mean_run(workload_t *w)
+{
+    switch(w->mrun)
+    {
+      case RUN_EXPONENTIAL :
+        return w->mrun_a;
+      case RUN_BIMODAL :
+        return w->mrun_c * w->mrun_a + (1.0 - w->mrun_c) * w->mrun_b;
+      case RUN_PARETO :
+        return w->mrun_a * w->mrun_b / (w->mrun_a - 1.0);
+    }
+    return 1.0;
+}
+
+static int workload_run_time(workload_t *w)
+{
+    double run = 1.0;
+    switch(w->mrun)
+    {
+      case RUN_EXPONENTIAL :
+        run = workload_exponential(w, w->mrun_a);
+        break;
+      case RUN_BIMODAL :
+        run = (workload_uniform(w) < w->mrun_c) ? w->mrun_a : w->mrun_b;
+        break;
+      case RUN_PARETO :
+        run = w->mrun_b / pow(workload_uniform(w), 1.0 / w->mrun_a);
+        break;
+    }
+    //every job needs at least one time unit, and has to fit in an int
+    if(run < 1.0)
+        return 1;
+    if(run > 1e9)
+        return 1000000000;
+    return (int)ceil(run);
+}
+
+static int workload_priority(workload_t *w)
+{
+    if(w->mpriority == PRIORITY_UNIFORM)
+        return w->mpri_lo + (int)(workload_uniform(w) * (w->mpri_hi - w->mpri_lo + 1));
+
+    //weighted: walk the cumulative weights
+    double u = workload_uniform(w) * w->mweights[w->mclasses - 1];
+    int i;
+    for(i = 0; i < w->mclasses - 1; i++)
+        if(u < w->mweights[i])
+            break;
+    return i;
+}
+
+/*
+  Generates the lookahead job, or marks the workload as exhausted
+*/
+static void workload_advance(workload_t *w)
+{
+    if(w->mjobs <= 0)
+        return;
+
+    if(w->marrival == ARRIVAL_POISSON)
+    {
+        w->mclock += workload_exponential(w, w->minterarrival);
+    }
+    else if(w->mburst == 0)
+    {
+        //start a new burst, every job of which arrives in the same time unit
+        w->mclock += workload_exponential(w, w->minterarrival);
+        w->mburst = workload_geometric(w, w->mburst_size);
+    }
+    if(w->marrival == ARRIVAL_BURSTY)
+        w->mburst--;
+
+    if(w->mclock > 2e9)
+    {
+        //ran out of time units, stop early rather than overflow
+        w->mjobs = 0;
+        return;
+    }
+
+    w->mnext_arrival = (int)w->mclock;
+    w->mnext_run = workload_run_time(w);
+    w->mnext_priority = workload_priority(w);
+}
+
+/*
+  Parses "name:a:b:c" into its name and up to max numeric arguments
+  @return the number of numeric arguments found
+*/
+static int workload_args(const char *value, double *args, int max)
+{
+    int n = 0;
+    const char *tok = strchr(value, ':');
+    while(tok != NULL && n < max)
+    {
+        char *end;
+        args[n] = strtod(tok + 1, &end);
+        //reject anything that isn't a number followed by another argument or the end
+        if(end == tok + 1 || (*end != ':' && *end != '\0'))
+            return -1;
+        n++;
+        tok = strchr(tok + 1, ':');
+    }
+    return tok == NULL ? n : -1;
+}
+
+/*
+  Whether value names the distribution name, the whole of the part before any arguments
+*/
+static int workload_is(const char *value, const char *name)
+{
+    size_t length = strcspn(value, ":");
+    return length == strlen(name) && strncasecmp(value, name, length) == 0;
+}
+
+/*
+  Parses a whole value as a number
+  @return 1 if the value was a number, 0 otherwise
+*/
+static int workload_number(const char *value, double *number)
+{
+    char *end;
+    *number = strtod(value, &end);
+    return end != value && *end == '\0';
+}
+
+
+/**
+  Initializes a workload generator from a specification string.
+
+  The specification is a comma separated list of key=value pairs, every one of
+  which is optional:
+    - seed=N              seed of the random number generator (default 1)
+    - jobs=N              number of jobs to generate, N >= 1 (default 1000)
+    - util=F              target utilisation of the cores, 0 < F (default 0.9)
+    - arrival=poisson     exponential inter-arrival times (default)
+    - arrival=bursty:B    Poisson bursts of on average B jobs arriving in the same time unit
+    - run=exp:M           exponential running times with mean M (default exp:10)
+    - run=bimodal:S:L:P   running time S with probability P, L otherwise
+    - run=pareto:A:M      Pareto running times with shape A > 1 and minimum M
+    - pri=uniform:L:H     priorities drawn uniformly from [L, H] (default uniform:0:9)
+    - pri=weights:W0:W1.. priority i drawn with relative weight Wi
+
+  @param w a pointer to an instance of the workload_t data structure
+  @param spec the specification string, may be empty
+  @param cores the number of cores the workload will run on, used for the target utilisation
+  @return 0 on success
+  @return -1 if the specification could not be parsed (an error has been printed to stderr)
+ */
+int workload_init(workload_t *w, const char *spec, int cores)
+{
+    memset(w, 0, sizeof(workload_t));
+    w->mseed = 1;
+    w->mtotal = 1000;
+    w->mutil = 0.9;
+    w->marrival = ARRIVAL_POISSON;
+    w->mburst_size = 1.0;
+    w->mrun = RUN_EXPONENTIAL;
+    w->mrun_a = 10.0;
+    w->mpriority = PRIORITY_UNIFORM;
+    w->mpri_lo = 0;
+    w->mpri_hi = 9;
+
+    char *copy = strdup(spec);
+    char *save = NULL;
+    char *pair;
+    int ok = 1;
+    double args[WORKLOAD_MAX_CLASSES];
+    double number;
+
+    for(pair = strtok_r(copy, ",", &save); pair != NULL && ok; pair = strtok_r(NULL, ",", &save))
+    {
+        char *value = strchr(pair, '=');
+        if(value == NULL)
+        {
+            fprintf(stderr, "Invalid workload parameter \"%s\", expected key=value.\n", pair);
+            ok = 0;
+            break;
+        }
+        *value++ = '\0';
+
+        if(strcasecmp(pair, "seed") == 0)
+        {
+            char *end;
+            w->mseed = strtoull(value, &end, 0);
+            ok = end != value && *end == '\0';
+        }
+        else if(strcasecmp(pair, "jobs") == 0)
+        {
+            ok = workload_number(value, &number) && number >= 1 && number <= 2e9;
+            w->mtotal = (long)number;
+        }
+        else if(strcasecmp(pair, "util") == 0)
+        {
+            ok = workload_number(value, &number) && number > 0;
+            w->mutil = number;
+        }
+        else if(workload_is(value, "poisson") && strcasecmp(pair, "arrival") == 0)
+        {
+            w->marrival = ARRIVAL_POISSON;
+            ok = workload_args(value, args, 0) == 0;
+        }
+        else if(workload_is(value, "bursty") && strcasecmp(pair, "arrival") == 0)
+        {
+            w->marrival = ARRIVAL_BURSTY;
+            int n = workload_args(value, args, 1);
+            w->mburst_size = n == 1 ? args[0] : 8.0;
+            ok = n >= 0 && w->mburst_size >= 1.0;
+        }
+        else if(workload_is(value, "exp") && strcasecmp(pair, "run") == 0)
+        {
+            w->mrun = RUN_EXPONENTIAL;
+            ok = workload_args(value, args, 1) == 1 && args[0] > 0;
+            w->mrun_a = args[0];
+        }
+        else if(workload_is(value, "bimodal") && strcasecmp(pair, "run") == 0)
+        {
+            w->mrun = RUN_BIMODAL;
+            ok = workload_args(value, args, 3) == 3 && args[2] >= 0 && args[2] <= 1;
+            w->mrun_a = args[0];
+            w->mrun_b = args[1];
+            w->mrun_c = args[2];
+        }
+        else if(workload_is(value, "pareto") && strcasecmp(pair, "run") == 0)
+        {
+            w->mrun = RUN_PARETO;
+            ok = workload_args(value, args, 2) == 2 && args[0] > 1 && args[1] > 0;
+            w->mrun_a = args[0];
+            w->mrun_b = args[1];
+        }
+        else if(workload_is(value, "uniform") && strcasecmp(pair, "pri") == 0)
+        {
+            w->mpriority = PRIORITY_UNIFORM;
+            ok = workload_args(value, args, 2) == 2 && args[0] <= args[1];
+            w->mpri_lo = (int)args[0];
+            w->mpri_hi = (int)args[1];
+        }
+        else if(workload_is(value, "weights") && strcasecmp(pair, "pri") == 0)
+        {
+            w->mpriority = PRIORITY_WEIGHTED;
+            w->mclasses = workload_args(value, args, WORKLOAD_MAX_CLASSES);
+            ok = w->mclasses > 0;
+            //store the weights cumulatively so drawing a class is a single walk
+            double sum = 0.0;
+            for(int i = 0; i < w->mclasses; i++)
+            {
+                ok = ok && args[i] >= 0;
+                sum += args[i];
+                w->mweights[i] = sum;
+            }
+            ok = ok && sum > 0;
+        }
+        else
+            ok = 0;
+
+        if(!ok)
+            fprintf(stderr, "Invalid workload parameter \"%s=%s\".\n", pair, value);
+    }
+    free(copy);
+
+    if(!ok)
+        return -1;
+
+    /*
+      Arrival rate that keeps the cores busy util of the time:
+        lambda = util * cores / mean_run
+      Bursts deliver mburst_size jobs each, so they come mburst_size times less often.
+    */
+    w->minterarrival = workload_mean_run(w) / (w->mutil * cores);
+    if(w->marrival == ARRIVAL_BURSTY)
+        w->minterarrival *= w->mburst_size;
+
+    w->mstate = workload_mix(w->mseed);
+    if(w->mstate == 0)
+        w->mstate = 1;
+    w->mjobs = w->mtotal;
+    w->mclock = 0.0;
+    w->mburst = 0;
+    workload_advance(w);
+    return 0;
+}
+
+
+/**
+  Returns the arrival time of the next job without consuming it.
+
+  @param w a pointer to an instance of the workload_t data structure
+  @return the arrival time of the next job
+  @return -1 if the workload is exhausted
+ */
+int workload_peek(workload_t *w)
+{
+    if(w->mjobs <= 0)
+        return -1;
+    return w->mnext_arrival;
+}
+
+
+/**
+  Hands out the next job. Jobs are produced in non-decreasing order of arrival time.
+
+  @param w a pointer to an instance of the workload_t data structure
+  @param arrival_time set to the arrival time of the job
+  @param run_time set to the running time of the job (always at least 1)
+  @param priority set to the priority of the job
+  @return 1 if a job was produced
+  @return 0 if the workload is exhausted
+ */
+int workload_next(workload_t *w, int *arrival_time, int *run_time, int *priority)
+{
+    if(w->mjobs <= 0)
+        return 0;
+
+    *arrival_time = w->mnext_arrival;
+    *run_time = w->mnext_run;
+    *priority = w->mnext_priority;
+
+    w->mjobs--;
+    workload_advance(w);
+    return 1;
+}
+
+
+/**
+  Returns the total number of jobs the workload was configured to produce.
+
+  @param w a pointer to an instance of the workload_t data structure
+  @return the number of jobs
+ */
+long workload_size(workload_t *w)
+{
+    return w->mtotal;
+}
+
+
+/**
+  Prints the effective parameters of the workload, so a run can be reproduced.
+
+  @param w a pointer to an instance of the workload_t data structure
+  @param out the stream to print to
+ */
+void workload_print(workload_t *w, FILE *out)
+{
+    fprintf(out, "seed=%llu,jobs=%ld,util=%g", w->mseed, w->mtotal, w->mutil);
+
+    if(w->marrival == ARRIVAL_POISSON)
+        fprintf(out, ",arrival=poisson");
+    else
+        fprintf(out, ",arrival=bursty:%g", w->mburst_size);
+
+    if(w->mrun == RUN_EXPONENTIAL)
+        fprintf(out, ",run=exp:%g", w->mrun_a);
+    else if(w->mrun == RUN_BIMODAL)
+        fprintf(out, ",run=bimodal:%g:%g:%g", w->mrun_a, w->mrun_b, w->mrun_c);
+    else
+        fprintf(out, ",run=pareto:%g:%g", w->mrun_a, w->mrun_b);
+
+    if(w->mpriority == PRIORITY_UNIFORM)
+        fprintf(out, ",pri=uniform:%d:%d", w->mpri_lo, w->mpri_hi);
+    else
+    {
+        fprintf(out, ",pri=weights");
+        for(int i = 0; i < w->mclasses; i++)
+            fprintf(out, ":%g", w->mweights[i] - (i > 0 ? w->mweights[i - 1] : 0.0));
+    }
+}
@@ -0,0 +1,75 @@
+/** @file libworkload.h
+ */
+
+#ifndef LIBWORKLOAD_H_
+#define LIBWORKLOAD_H_
+
+#include <stdio.h>
+
+/**
+  Constants which represent the supported arrival processes
+*/
+typedef enum {ARRIVAL_POISSON = 0, ARRIVAL_BURSTY} arrival_dist_t;
+
+/**
+  Constants which represent the supported running time distributions
+*/
+typedef enum {RUN_EXPONENTIAL = 0, RUN_BIMODAL, RUN_PARETO} run_dist_t;
+
+/**
+  Constants which represent the supported priority distributions
+*/
+typedef enum {PRIORITY_UNIFORM = 0, PRIORITY_WEIGHTED} priority_dist_t;
+
+#define WORKLOAD_MAX_CLASSES 16
+
+/**
+ *  Workload Generator Structure
+ *  Member variables:
+ *      mstate = the state of the pseudo random number generator
+ *      mseed = the seed the generator was started with
+ *      mtotal = the total number of jobs the workload will produce
+ *      mjobs = the number of jobs still to be handed out (including the lookahead job)
+ *      mclock = the arrival clock, in fractional time units
+ *      mburst = the number of jobs left in the current burst (bursty arrivals only)
+ *      mnext_* = the lookahead job, so the caller can peek at the next arrival time
+ *      the remaining members are the parsed distribution parameters
+ */
+typedef struct _workload_t
+{
+    unsigned long long mstate;
+    unsigned long long mseed;
+    long mtotal;
+    long mjobs;
+    double mclock;
+    long mburst;
+
+    int mnext_arrival;
+    int mnext_run;
+    int mnext_priority;
+
+    arrival_dist_t marrival;
+    double minterarrival; //mean time between arrivals (or between bursts)
+    double mburst_size; //mean number of jobs per burst
+
+    run_dist_t mrun;
+    double mrun_a; //exp: mean, bimodal: short, pareto: alpha
+    double mrun_b; //bimodal: long, pareto: minimum
+    double mrun_c; //bimodal: probability of the short mode
+
+    priority_dist_t mpriority;
+    int mpri_lo; //uniform: lowest priority value
+    int mpri_hi; //uniform: highest priority value
+    int mclasses; //weighted: number of priority classes
+    double mweights[WORKLOAD_MAX_CLASSES]; //weighted: cumulative weight of each class
+
+    double mutil; //target utilisation
+} workload_t;
+
+int  workload_init   (workload_t *w, const char *spec, int cores);
+int  workload_peek   (workload_t *w);
+int  workload_next   (workload_t *w, int *arrival_time, int *run_time, int *priority);
+long workload_size   (workload_t *w);
+void workload_print  (workload_t *w, FILE *out);
+
+#endif /* LIBWORKLOAD_H_ */
@@ -1,74 +1,169 @@
-/** @file queuetest.c
- */
-
-#include <stdio.h>
-#include <stdlib.h>
-
-#include "libpriqueue/libpriqueue.h"
-
-int compare1(const void * a, const void * b)
-{
-	return ( *(int*)a - *(int*)b );
-}
-
-int compare2(const void * a, const void * b)
-{
-	return ( *(int*)b - *(int*)a );
-}
-
-int main()
-{
-	priqueue_t q, q2;
-
-	priqueue_init(&q, compare1);
-	priqueue_init(&q2, compare2);
-
-	/* Pupulate some data... */
-	int *values = malloc(100 * sizeof(int));
-
-	int i;
-	for (i = 0; i < 100; i++)
-		values[i] = i;
-
-	/* Add 5 values, 3 unique. */
-	priqueue_offer(&q, &values[12]);
-	priqueue_offer(&q, &values[13]);
-	priqueue_offer(&q, &values[14]);
-	priqueue_offer(&q, &values[12]);
-	priqueue_offer(&q, &values[12]);
-	printf("Total elements: %d (expected 5).\n", priqueue_size(&q));
-
-	int val = *((int *)priqueue_poll(&q));
-	printf("Top element: %d (expected 12).\n", val);
-	printf("Total elements: %d (expected 4).\n", priqueue_size(&q));
-
-	int vals_removed = priqueue_remove(&q, &values[12]);
-	printf("Elements removed: %d (expected 2).\n", vals_removed);
-	printf("Total elements: %d (expected 2).\n", priqueue_size(&q));
-
-	priqueue_offer(&q, &values[10]);
-	priqueue_offer(&q, &values[30]);
-	priqueue_offer(&q, &values[20]);
-
-	priqueue_offer(&q2, &values[10]);
-	priqueue_offer(&q2, &values[30]);
-	priqueue_offer(&q2, &values[20]);
-
-
-	printf("Elements in order queue (expected 10 13 14 20 30): ");
-	for (i = 0; i < priqueue_size(&q); i++)
-		printf("%d ", *((int *)priqueue_at(&q, i)) );
-	printf("\n");
-
-	printf("Elements in reverse order queue (expected 30 20 10): ");
-	for (i = 0; i < priqueue_size(&q2); i++)
-		printf("%d ", *((int *)priqueue_at(&q2, i)) );
-	printf("\n");
-
-	priqueue_destroy(&q2);
-	priqueue_destroy(&q);
-
-	free(values);
-
-	return 0;
-}
+/** @file queuetest.c
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "libpriqueue/libpriqueue.h"
+
+int compare1(const void * a, const void * b)
+{
+	return ( *(int*)a - *(int*)b );
+}
+
+int compare2(const void * a, const void * b)
+{
+	return ( *(int*)b - *(int*)a );
+}
+
+/* An element with the node of an intrusive queue embedded in it. */
+typedef struct _item_t
+{
+	int value;
+	node_t node;
+} item_t;
+
+int main()
+{
+	priqueue_t q, q2;
+
+	priqueue_init(&q, compare1);
+	priqueue_init(&q2, compare2);
+
+	/* Pupulate some data... */
+	int *values = malloc(100 * sizeof(int));
+
+	int i;
+	for (i = 0; i < 100; i++)
+		values[i] = i;
+
+	/* Add 5 values, 3 unique. */
+	priqueue_offer(&q, &values[12]);
+	priqueue_offer(&q, &values[13]);
+	priqueue_offer(&q, &values[14]);
+	priqueue_offer(&q, &values[12]);
+	priqueue_offer(&q, &values[12]);
+	printf("Total elements: %d (expected 5).\n", priqueue_size(&q));
+
+	int val = *((int *)priqueue_poll(&q));
+	printf("Top element: %d (expected 12).\n", val);
+	printf("Total elements: %d (expected 4).\n", priqueue_size(&q));
+
+	int vals_removed = priqueue_remove(&q, &values[12]);
+	printf("Elements removed: %d (expected 2).\n", vals_removed);
+	printf("Total elements: %d (expected 2).\n", priqueue_size(&q));
+
+	priqueue_offer(&q, &values[10]);
+	priqueue_offer(&q, &values[30]);
+	priqueue_offer(&q, &values[20]);
+
+	priqueue_offer(&q2, &values[10]);
+	priqueue_offer(&q2, &values[30]);
+	priqueue_offer(&q2, &values[20]);
+
+
+	printf("Elements in order queue (expected 10 13 14 20 30): ");
+	for (i = 0; i < priqueue_size(&q); i++)
+		printf("%d ", *((int *)priqueue_at(&q, i)) );
+	printf("\n");
+
+	printf("Elements in reverse order queue (expected 30 20 10): ");
+	for (i = 0; i < priqueue_size(&q2); i++)
+		printf("%d ", *((int *)priqueue_at(&q2, i)) );
+	printf("\n");
+
+	/* Insert a batch at once. */
+	void *batch[3] = { &values[25], &values[5], &values[15] };
+	priqueue_offer_all(&q2, batch, 3);
+
+	/* Walk the queue with an iterator rather than priqueue_at(), O(n) instead of O(n^2). */
+	priqueue_iter_t it;
+	int *ptr;
+
+	printf("Elements after batch insert (expected 30 25 20 15 10 5): ");
+	priqueue_iter_begin(&q2, &it);
+	while ((ptr = priqueue_iter_next(&it)) != NULL)
+		printf("%d ", *ptr);
+	printf("\n");
+
+	void *array[4];
+	int copied = priqueue_to_array(&q2, array, 4);
+
+	printf("First %d elements copied out (expected 4: 30 25 20 15): ", copied);
+	for (i = 0; i < copied; i++)
+		printf("%d ", *((int *)array[i]) );
+	printf("\n");
+
+	/* A keyed queue orders by the key offered with each element, equal keys first come first served. */
+	priqueue_t q3;
+	priqueue_init_keyed(&q3);
+	priqueue_offer_keyed(&q3, &values[1], 3);
+	priqueue_offer_keyed(&q3, &values[2], 1);
+	priqueue_offer_keyed(&q3, &values[3], 3);
+	priqueue_offer_keyed(&q3, &values[4], 2);
+
+	printf("Elements in keyed queue (expected 2 4 1 3): ");
+	priqueue_iter_begin(&q3, &it);
+	while ((ptr = priqueue_iter_next(&it)) != NULL)
+		printf("%d ", *ptr);
+	printf("\n");
+
+	/* An intrusive queue links the nodes embedded in its elements, in the same order. */
+	priqueue_t q4;
+	item_t items[4] = { { 1, { NULL, NULL, 0 } }, { 2, { NULL, NULL, 0 } }, { 3, { NULL, NULL, 0 } }, { 4, { NULL, NULL, 0 } } };
+	priqueue_init_intrusive(&q4, NULL, offsetof(item_t, node));
+	priqueue_offer_keyed(&q4, &items[0], 3);
+	priqueue_offer_keyed(&q4, &items[1], 1);
+	priqueue_offer_keyed(&q4, &items[2], 3);
+	priqueue_offer_keyed(&q4, &items[3], 2);
+	priqueue_remove_at(&q4, 2);
+
+	printf("Elements in intrusive queue after removing index 2 (expected 2 4 3): ");
+	item_t *item;
+	while ((item = priqueue_poll(&q4)) != NULL)
+		printf("%d ", item->value);
+	printf("\n");
+
+	/* With a comparer an intrusive queue relinks the embedded nodes, so a polled element can come back. */
+	priqueue_t q6;
+	item_t items2[3] = { { 5, { NULL, NULL, 0 } }, { 1, { NULL, NULL, 0 } }, { 3, { NULL, NULL, 0 } } };
+	priqueue_init_intrusive(&q6, compare1, offsetof(item_t, node));
+	priqueue_offer(&q6, &items2[0]);
+	priqueue_offer(&q6, &items2[1]);
+	item = priqueue_poll(&q6);
+	priqueue_offer(&q6, item);
+	priqueue_offer(&q6, &items2[2]);
+
+	printf("Elements in intrusive queue with a comparer (expected 1 3 5): ");
+	while ((item = priqueue_poll(&q6)) != NULL)
+		printf("%d ", item->value);
+	printf("\n");
+
+	/* A ring queue appends elements that come in key order, and still places any that do not. */
+	priqueue_t q5;
+	priqueue_init_ring(&q5);
+	for (i = 0; i < 40; i++)
+		priqueue_offer_keyed(&q5, &values[i], i / 2);
+	for (i = 0; i < 30; i++)
+		priqueue_poll(&q5);
+	priqueue_offer_keyed(&q5, &values[40], 17);
+	priqueue_offer_keyed(&q5, &values[41], 30);
+	priqueue_remove(&q5, &values[32]);
+
+	printf("Elements in ring queue (expected 30 31 33 34 35 40 36 37 38 39 41): ");
+	priqueue_iter_begin(&q5, &it);
+	while ((ptr = priqueue_iter_next(&it)) != NULL)
+		printf("%d ", *ptr);
+	printf("\n");
+
+	priqueue_destroy(&q6);
+	priqueue_destroy(&q5);
+	priqueue_destroy(&q4);
+	priqueue_destroy(&q3);
+	priqueue_destroy(&q2);
+	priqueue_destroy(&q);
+
+	free(values);
+
+	return 0;
+}
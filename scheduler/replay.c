@@ -0,0 +1,297 @@
+/** @file replay.c
+ *
+ * Replays a call trace recorded by the simulator's -T option against libscheduler,
+ * without any of the simulator's bookkeeping or printing, and checks that every
+ * call makes the same decision it made when the trace was recorded.
+ *
+ * The trace is first replayed <passes> times untimed, for the overall throughput,
+ * then once more timing every call, for the mean and a log2 histogram of the time
+ * per call of each call type (less the measured cost of reading the clock).
+ *
+ * Usage: ./replay [-n passes] <trace file>
+ * Exits with 0 if every decision matched, 1 on the first mismatch and 2 on error.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "libscheduler/libscheduler.h"
+#include "libcalltrace/libcalltrace.h"
+
+#define BUCKETS 40
+
+typedef struct _call_stats_t
+{
+	long count;
+	double total_ns;
+	long histogram[BUCKETS]; //bucket i counts calls taking [2^i, 2^(i+1)) ns, bucket 0 everything under 2 ns
+} call_stats_t;
+
+static const char *scheme_names[] = { "FCFS", "SJF", "PSJF", "PRI", "PPRI", "RR" };
+static call_stats_t stats[CALL_SET_AGING + 1];
+static double clock_overhead_ns;
+
+static double now_ns()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*
+ * The cheapest back to back clock reading seen, taken off every timed call.
+ */
+static double measure_clock_overhead()
+{
+	double best = 1e9;
+	int i;
+
+	for (i = 0; i < 10000; i++)
+	{
+		double start = now_ns();
+		double elapsed = now_ns() - start;
+		if (elapsed < best)
+			best = elapsed;
+	}
+
+	return best;
+}
+
+static void record_time(call_type_t type, double ns)
+{
+	int bucket = 0;
+
+	ns -= clock_overhead_ns;
+	if (ns < 0)
+		ns = 0;
+
+	while (bucket < BUCKETS - 1 && ns >= (double)(2L << bucket))
+		bucket++;
+
+	stats[type].count++;
+	stats[type].total_ns += ns;
+	stats[type].histogram[bucket]++;
+}
+
+static void print_mismatch(call_t *calls, long i, int result)
+{
+	call_t *call = &calls[i];
+
+	printf("Decision mismatch at record %ld (time %d): %s(", i, call->time, calltrace_type_name(call->type));
+	if (call->type == CALL_ARRIVAL)
+		printf("job %d, running time %d, priority %d) was given core %d, the trace says %d.\n", call->a, call->b, call->c, result, call->result);
+	else if (call->type == CALL_JOB_FINISHED || call->type == CALL_JOB_BLOCKED)
+		printf("core %d, job %d) returned %d, the trace says %d.\n", call->a, call->b, result, call->result);
+	else if (call->type == CALL_JOB_WOKE)
+		printf("job %d) returned %d, the trace says %d.\n", call->a, result, call->result);
+	else
+		printf("core %d) returned %d, the trace says %d.\n", call->a, result, call->result);
+}
+
+/*
+ * Replays the trace once, between scheduler_start_up() and scheduler_clean_up().
+ * @return 1 if every decision matched, 0 otherwise (the mismatch has been printed)
+ */
+static int replay(call_t *calls, long count, scheduler_arrival_t *batch, int timed)
+{
+	long i;
+	int j, result = 0;
+	double start = 0;
+
+	scheduler_start_up(calls[0].a, calls[0].b);
+
+	for (i = 1; i < count; i++)
+	{
+		call_t *call = &calls[i];
+
+		switch (call->type)
+		{
+			case CALL_NEW_JOBS:
+				for (j = 0; j < call->a; j++)
+				{
+					batch[j].job_number = call[j + 1].a;
+					batch[j].running_time = call[j + 1].b;
+					batch[j].priority = call[j + 1].c;
+				}
+
+				if (timed)
+					start = now_ns();
+				scheduler_new_jobs(batch, call->a, call->time);
+				if (timed)
+					record_time(CALL_NEW_JOBS, now_ns() - start);
+
+				for (j = 0; j < call->a; j++)
+				{
+					if (batch[j].core != call[j + 1].result)
+					{
+						print_mismatch(calls, i + 1 + j, batch[j].core);
+						return 0;
+					}
+				}
+				i += call->a;
+				continue;
+
+			case CALL_JOB_FINISHED:
+				if (timed)
+					start = now_ns();
+				result = scheduler_job_finished(call->a, call->b, call->time);
+				if (timed)
+					record_time(CALL_JOB_FINISHED, now_ns() - start);
+				break;
+
+			case CALL_QUANTUM_EXPIRED:
+				if (timed)
+					start = now_ns();
+				result = scheduler_quantum_expired(call->a, call->time);
+				if (timed)
+					record_time(CALL_QUANTUM_EXPIRED, now_ns() - start);
+				break;
+
+			case CALL_JOB_BLOCKED:
+				if (timed)
+					start = now_ns();
+				result = scheduler_job_blocked(call->a, call->b, call->time);
+				if (timed)
+					record_time(CALL_JOB_BLOCKED, now_ns() - start);
+				break;
+
+			case CALL_JOB_WOKE:
+				if (timed)
+					start = now_ns();
+				result = scheduler_job_woke(call->a, call->time);
+				if (timed)
+					record_time(CALL_JOB_WOKE, now_ns() - start);
+				break;
+
+			case CALL_SET_ADMISSION:
+				scheduler_set_admission(call->a, call->b, call->c);
+				continue;
+
+			case CALL_SET_AGING:
+				scheduler_set_aging(call->a);
+				continue;
+
+			case CALL_SET_QUANTUM:
+				scheduler_set_quantum_target(call->a, call->b, call->c);
+				continue;
+
+			case CALL_CORE_QUANTUM:
+				result = scheduler_core_quantum(call->a);
+				break;
+
+			default:
+				fprintf(stderr, "Unexpected %s record at %ld.\n", calltrace_type_name(call->type), i);
+				return 0;
+		}
+
+		if (result != call->result)
+		{
+			print_mismatch(calls, i, result);
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+int main(int argc, char **argv)
+{
+	int c, passes = 3, pass, max_batch = 1;
+	long count, i, calls_made = 0;
+
+	while ((c = getopt(argc, argv, "n:")) != -1)
+	{
+		if (c == 'n' && atoi(optarg) > 0)
+			passes = atoi(optarg);
+		else
+		{
+			fprintf(stderr, "Usage: %s [-n passes] <trace file>\n", argv[0]);
+			return 2;
+		}
+	}
+
+	if (optind != argc - 1)
+	{
+		fprintf(stderr, "Usage: %s [-n passes] <trace file>\n", argv[0]);
+		return 2;
+	}
+
+	call_t *calls = calltrace_load(argv[optind], &count);
+	if (calls == NULL || count == 0 || calls[0].type != CALL_START_UP || calls[0].a <= 0 || calls[0].b < FCFS || calls[0].b > RR)
+	{
+		fprintf(stderr, "Unable to read \"%s\" as a call trace.\n", argv[optind]);
+		return 2;
+	}
+
+	// Check the batches are complete, and size the buffer for the largest
+	for (i = 1; i < count; i++)
+	{
+		if (calls[i].type == CALL_NEW_JOBS)
+		{
+			if (calls[i].a < 0 || i + calls[i].a >= count)
+			{
+				fprintf(stderr, "\"%s\" ends in the middle of a batch of arrivals.\n", argv[optind]);
+				return 2;
+			}
+			if (calls[i].a > max_batch)
+				max_batch = calls[i].a;
+			calls_made++;
+			i += calls[i].a;
+		}
+		else
+			calls_made++;
+	}
+
+	scheduler_arrival_t *batch = malloc(max_batch * sizeof(scheduler_arrival_t));
+	double best = 0;
+
+	for (pass = 0; pass < passes; pass++)
+	{
+		double start = now_ns();
+		if (!replay(calls, count, batch, 0))
+			return 1;
+		double elapsed = now_ns() - start;
+
+		if (pass == 0 || elapsed < best)
+			best = elapsed;
+		scheduler_clean_up();
+	}
+
+	clock_overhead_ns = measure_clock_overhead();
+	if (!replay(calls, count, batch, 1))
+		return 1;
+
+	printf("Replayed %ld scheduler call(s) on %d core(s) under %s, every decision matched.\n", calls_made, calls[0].a, scheme_names[calls[0].b]);
+	printf("Untimed, best of %d pass(es): %.3f s, %.1f ns per call\n", passes, best / 1e9, best / calls_made);
+	printf("Averages: waiting %.2f, turnaround %.2f, response %.2f\n",
+			scheduler_average_waiting_time(), scheduler_average_turnaround_time(), scheduler_average_response_time());
+	printf("\n");
+	printf("Timed pass (%.0f ns clock overhead removed from each call):\n", clock_overhead_ns);
+
+	for (c = CALL_NEW_JOBS; c <= CALL_JOB_WOKE; c++)
+	{
+		int bucket;
+
+		if (stats[c].count == 0)
+			continue;
+
+		printf("  %-16s %10ld call(s), mean %8.1f ns\n", calltrace_type_name(c), stats[c].count, stats[c].total_ns / stats[c].count);
+		for (bucket = 0; bucket < BUCKETS; bucket++)
+		{
+			if (stats[c].histogram[bucket] == 0)
+				continue;
+
+			printf("    %10ld ns and up: %10ld (%5.1f%%)\n", bucket == 0 ? 0L : 1L << bucket,
+					stats[c].histogram[bucket], 100.0 * stats[c].histogram[bucket] / stats[c].count);
+		}
+	}
+
+	scheduler_clean_up();
+	free(batch);
+	free(calls);
+
+	return 0;
+}
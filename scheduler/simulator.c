@@ -1,487 +1,2666 @@
-#include <stdio.h>
-#include <stdlib.h>
-#include <unistd.h>
-#include <string.h>
-#include <assert.h>
-
-#include "libscheduler/libscheduler.h"
-
-
-typedef struct _simulator_job_list_t
-{
-	int job_id, arrival_time, run_time, priority;
-	int core_id, arrived;
-} simulator_job_list_t;
-
-void print_usage(char *program_name)
-{
-	fprintf(stderr, "Usage: %s -c <cores> -s <scheme> <input file>\n", program_name);
-	fprintf(stderr, "       %s -c 2 -s fcfs examples/proc1.csv\n", program_name);
-	fprintf(stderr, "\n");
-	fprintf(stderr, "Acceptable schemes are: fcfs, sjf, psjf, pri, ppri, rr#\n");
-}
-
-int set_active_job(int job_id, int core_id, simulator_job_list_t *jobs, int active_jobs)
-{
-	int i;
-	for (i = 0; i < active_jobs; i++)
-	{
-		if (jobs[i].job_id == job_id && jobs[i].arrived)
-		{
-			jobs[i].core_id = core_id;
-			return 1;
-		}
-	}
-
-	return 0;
-}
-
-void print_available_jobs(simulator_job_list_t *jobs, int active_jobs)
-{
-	printf("Active jobs are: ");
-
-	int i, first = 1;
-	for (i = 0; i < active_jobs; i++)
-	{
-		if (jobs[i].arrived)
-		{
-			if (first)
-			{
-				printf("%d", jobs[i].job_id);
-				first = 0;
-			}
-			else
-				printf(", %d", jobs[i].job_id);
-		}
-	}
-
-	if (!first)
-		printf("\n");
-}
-
-void print_available_cores(int cores)
-{
-	printf("Active cores are: ");
-
-	int i;
-	for (i = 0; i < cores; i++)
-	{
-		if (i == cores - 1)
-			printf("%d\n", i);
-		else
-			printf("%d, ", i);
-	}
-}
-
-
-int main(int argc, char **argv)
-{
-	int c;
-	int cores = 0, scheme = -1, quantum = 0;
-	char *file_name;
-
-	/*
-	 * Parse command line options.
-	 */
-	while ((c = getopt(argc, argv, "c:s:")) != -1)
-	{
-		switch (c)
-		{
-			case 'c':
-				cores = atoi(optarg);
-
-				if (cores <= 0)
-				{
-					fprintf(stderr, "Option -c <cores> require a positive number.\n");
-					print_usage(argv[0]);
-					return 1;
-				}
-				break;
-
-			case 's':
-				if (strcasecmp(optarg, "FCFS") == 0) { scheme = FCFS; }
-				else if (strcasecmp(optarg, "SJF") == 0) { scheme = SJF; }
-				else if (strcasecmp(optarg, "PSJF") == 0) { scheme = PSJF; }
-				else if (strcasecmp(optarg, "PRI") == 0) { scheme = PRI; }
-				else if (strcasecmp(optarg, "PPRI") == 0) { scheme = PPRI; }
-				else if (strncasecmp(optarg, "RR", 2) == 0)
-				{
-					scheme = RR;
-					quantum = atoi(optarg + 2);
-
-					if (quantum <= 0)
-					{
-						fprintf(stderr, "Option -s <scheme> requires a positive number for the quantum of RR. (Eg: -s RR2)\n");
-						print_usage(argv[0]);
-						return 1;
-					}
-				}
-				break;
-
-			case '?':
-				print_usage(argv[0]);
-				return 1;
-
-			default:
-				printf("...\n");
-				break;
-		}
-	}
-
-	if (cores == 0)
-	{
-		fprintf(stderr, "Required option -c <cores> is not present.\n");
-		print_usage(argv[0]);
-		return 1;
-	}
-
-	if (scheme == -1)
-	{
-		fprintf(stderr, "Required option -s <scheme> is not present.\n");
-		print_usage(argv[0]);
-		return 1;
-	}
-
-	if (optind == argc - 1)
-		file_name = argv[optind];
-	else
-	{
-		fprintf(stderr, "A single input file is required.\n");
-		print_usage(argv[0]);
-		return 1;
-	}
-
-
-	/*
-	 * Open the file, read the file, and populate the jobs data structure.
-	 */
-	FILE *file = fopen(file_name, "r");
-	if (file == NULL)
-	{
-		fprintf(stderr, "Unable to open file \"%s\".\n", file_name);
-		return 2;
-	}
-
-
-	int job_id = 0;
-	int jobs_ct = 10;
-	simulator_job_list_t* jobs = malloc(jobs_ct * sizeof(simulator_job_list_t));
-
-	char line[1024 + 1];
-	fgets(line, 1024, file);  // Ignore the first (header) line
-	while (fgets(line, 1024, file) != NULL)
-	{
-		char *arrival_time = strtok(line, ",");
-		char *run_time = strtok(NULL, ",");
-		char *priority = strtok(NULL, ",");
-
-		if (arrival_time != NULL && run_time != NULL && priority != NULL)
-		{
-			if (job_id == jobs_ct)
-			{
-				jobs_ct *= 2;
-				jobs = realloc(jobs, jobs_ct * sizeof(simulator_job_list_t));
-
-				if (!jobs)
-				{
-					fprintf(stderr, "Out of memory.\n");
-					return 2;
-				}
-			}
-
-			jobs[job_id].job_id = job_id;
-			jobs[job_id].arrival_time = atoi(arrival_time);
-			jobs[job_id].run_time = atoi(run_time);
-			jobs[job_id].priority = atoi(priority);
-			jobs[job_id].core_id = -1;
-			jobs[job_id].arrived = 0;
-
-			job_id++;
-		}
-		else
-		{
-			fprintf(stderr, "Illegal file format.\n");
-			return 2;
-		}
-	}
-
-	fclose(file);
-
-
-	/*
-	 * Run the simulation.
-	 */
-
-	printf("Loaded %d core(s) and %d job(s) using ", cores, job_id);
-	if (scheme == FCFS) { printf("First Come First Served (FCFS)"); }
-	else if (scheme == SJF) { printf("Non-preemptive Shortest Job First (SJF)"); }
-	else if (scheme == PSJF) { printf("Preemptive Shortest Job First (PSJF)"); }
-	else if (scheme == PRI) { printf("Non-preemptive Priority (PRI)"); }
-	else if (scheme == PPRI) { printf("Preemptive Priority (PPRI)"); }
-	else if (scheme == RR) { printf("Round Robin (RR) with a quantum of %d", quantum); }
-	printf(" scheduling...\n\n");
-
-	scheduler_start_up(cores, scheme);
-
-
-	int time = 0, i, j;
-	int active_jobs = job_id, jobs_alive = 0;
-
-	int *quantum_clock = malloc(cores * sizeof(int));
-	char **core_timing_diagram = malloc(cores * sizeof(char *));
-	int core_timing_diagram_size = 1024;
-
-	for (i = 0; i < cores; i++)
-	{
-		quantum_clock[i] = -1;
-		core_timing_diagram[i] = malloc(core_timing_diagram_size + 1);
-		core_timing_diagram[i][0] = '\0';
-	}
-
-	while (active_jobs > 0)
-	{
-		printf("=== [TIME %d] ===\n", time);
-
-		/*
-		 * 1. Check if any jobs finished in the last time unit.
-		 */
-		for (i = 0; i < active_jobs; i++)
-		{
-			if (jobs[i].run_time == 0)
-			{
-				// Notify the scheduler has finished
-				int job_id = jobs[i].job_id;
-				int core_id = jobs[i].core_id;
-				int new_job_id = scheduler_job_finished(jobs[i].core_id, jobs[i].job_id, time);
-
-				if (scheme == RR)
-					quantum_clock[jobs[i].core_id] = quantum;
-
-				// Delete the finished jobs, decrease the number of active jobs
-				if (i != active_jobs - 1)
-					memcpy(&jobs[i], &jobs[active_jobs - 1], sizeof(simulator_job_list_t));
-				active_jobs--;
-				jobs_alive--;
-				i--;
-
-				// Set the new job
-				if ( new_job_id != -1 && !set_active_job(new_job_id, core_id, jobs, active_jobs) )
-				{
-					printf("The scheduler_job_finished() selected an invalid job (job_id == %d).\n", new_job_id);
-					print_available_jobs(jobs, active_jobs);
-					return 3;
-				}
-				else
-				{
-					printf("Job %d, running on core %d, finished. Core %d is now running job %d.\n", job_id, core_id, core_id, new_job_id);
-					printf("  Queue: "); scheduler_show_queue(); printf("\n\n");
-				}
-			}
-		}
-
-		/*
-		 * Check to see if we finished our last job.  (If we don't check here, we would run an extra time unit that will be totally idle.)
-		 */
-		if (active_jobs == 0)
-			break;
-
-		/*
-		 * 2. Check of any quantums expired in the last time unit.
-		 */
-		if (scheme == RR)
-		{
-			for (i = 0; i < cores; i++)
-			{
-				if (quantum_clock[i] == 0)
-				{
-					for (j = 0; j < active_jobs; j++)
-					{
-						if (jobs[j].core_id == i)
-						{
-							// Notify the scheduler the quantum has expired
-							int core_id = jobs[j].core_id;
-							int old_job_id = jobs[j].job_id;
-							int new_job_id = scheduler_quantum_expired(jobs[j].core_id, time);
-
-							jobs[j].core_id = -1;
-
-							quantum_clock[core_id] = quantum;
-
-							// Set the new job
-							if ( new_job_id != -1 && !set_active_job(new_job_id, core_id, jobs, active_jobs) )
-							{
-								printf("The scheduler_quantum_expired() selected an invalid job (job_id == %d).\n", new_job_id);
-								print_available_jobs(jobs, active_jobs);
-								return 3;
-							}
-							else
-							{
-								printf("Job %d, running on core %d, had its quantum expire. Core %d is now running job %d.\n", old_job_id, core_id, core_id, new_job_id);
-								printf("  Queue: "); scheduler_show_queue(); printf("\n\n");
-							}
-
-							break;
-						}
-					}
-				}
-			}
-		}
-
-
-		/*
-		 * 3. Check for any new jobs that arrive in this time unit
-		 */
-		for (i = 0; i < active_jobs; i++)
-		{
-			if (jobs[i].arrival_time == time)
-			{
-				int new_job_core_id = scheduler_new_job(jobs[i].job_id, time, jobs[i].run_time, jobs[i].priority);
-				jobs[i].arrived = 1;
-				jobs_alive++;
-
-				if (new_job_core_id >= 0 && new_job_core_id < cores)
-				{
-					printf("A new job, job %d (running time=%d, priority=%d), arrived. Job %d is now running on core %d.\n",
-							jobs[i].job_id, jobs[i].run_time, jobs[i].priority, jobs[i].job_id, new_job_core_id);
-					printf("  Queue: "); scheduler_show_queue(); printf("\n\n");
-
-					// Find if anyone is currently using the core.
-					for (j = 0; j < active_jobs; j++)
-						if (jobs[j].core_id == new_job_core_id)
-							jobs[j].core_id = -1;
-
-					// Assign the core to the new job
-					jobs[i].core_id = new_job_core_id;
-
-					if (scheme == RR)
-						quantum_clock[new_job_core_id] = quantum;
-				}
-				else if (new_job_core_id == -1)
-				{
-					printf("A new job, job %d (running time=%d, priority=%d), arrived. Job %d is set to idle (-1).\n",
-							jobs[i].job_id, jobs[i].run_time, jobs[i].priority, jobs[i].job_id);
-					printf("  Queue: "); scheduler_show_queue(); printf("\n\n");
-				}
-				else
-				{
-					printf("The scheduler_new_job() selected an invalid core (core_id == %d).\n", new_job_core_id);
-					print_available_cores(cores);
-					return 3;
-				}
-			}
-		}
-
-
-		/*
-		 * 4. Run the time unit.
-		 */
-		char time_string[cores][11];
-		int cores_working = 0;
-
-		for (i = 0; i < cores; i++)
-			time_string[i][0] = '\0';
-
-		for (i = 0; i < active_jobs; i++)
-		{
-			if (jobs[i].core_id != -1)
-			{
-				cores_working++;
-				jobs[i].run_time--;
-				quantum_clock[jobs[i].core_id]--;
-
-				assert(time_string[jobs[i].core_id][0] == '\0');
-
-				if (jobs[i].job_id < 10)
-					sprintf(time_string[jobs[i].core_id], "%d", jobs[i].job_id);
-				else if (jobs[i].job_id < 10 + 26)
-					sprintf(time_string[jobs[i].core_id], "%c", jobs[i].job_id - 10 + 'a');
-				else if (jobs[i].job_id < 10 + 26 + 26)
-					sprintf(time_string[jobs[i].core_id], "%c", jobs[i].job_id - 10 - 26 + 'A');
-				else
-					snprintf(time_string[jobs[i].core_id], 10, "(%d)", jobs[i].job_id);
-			}
-		}
-
-		for (i = 0; i < cores; i++)
-		{
-			// If the core is idle, print a '-'
-			if (time_string[i][0] == '\0')
-				strcpy(time_string[i], "-");
-
-			// Ensure we have enough memory
-			while (strlen(core_timing_diagram[i]) + strlen(time_string[i]) >= (unsigned int)core_timing_diagram_size)
-			{
-				core_timing_diagram_size *= 2;
-
-				for (j = 0; j < cores; j++)
-				{
-					core_timing_diagram[j] = realloc(core_timing_diagram[j], core_timing_diagram_size + 1);
-
-					if (core_timing_diagram[j] == NULL)
-					{
-						fprintf(stderr, "Out of memory.\n");
-						return 3;
-					}
-				}
-			}
-
-			strcat( core_timing_diagram[i], time_string[i] );
-		}
-
-
-		/*
-		 * 5. Print data!
-		 */
-		printf("At the end of time unit %d...\n", time);
-
-		for (i = 0; i < cores; i++)
-			printf("  Core %2d: %s\n", i, core_timing_diagram[i]);
-
-		printf("\n");
-
-		printf("  Queue: ");
-		scheduler_show_queue();
-		printf("\n");
-		printf("\n");
-
-
-		/*
-		 * 6. Sanity Checking
-		 *
-		 * - If there's a job alive (needing to be ran) and all CPUs are idle, the scheduler failed to schedule properly.
-		 */
-		if (jobs_alive > 0 && cores_working == 0)
-		{
-			printf("All cores are idle and at least one job remains unscheduled.\n");
-			print_available_jobs(jobs, active_jobs);
-			return 3;
-		}
-
-
-		/*
-		 * 7. Increase time
-		 */
-		time++;
-	}
-
-
-	printf("FINAL TIMING DIAGRAM:\n");
-	for (i = 0; i < cores; i++)
-		printf("  Core %2d: %s\n", i, core_timing_diagram[i]);
-
-	printf("\n");
-	printf("Average Waiting Time: %.2f\n", scheduler_average_waiting_time());
-	printf("Average Turnaround Time: %.2f\n", scheduler_average_turnaround_time());
-	printf("Average Response Time: %.2f\n", scheduler_average_response_time());
-
-	scheduler_clean_up();
-
-
-	free(quantum_clock);
-	for (i=0; i < cores; i++)
-		free(core_timing_diagram[i]);
-	free(core_timing_diagram);
-	free(jobs);
-
-	return 0;
-}
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <strings.h>
+#include <assert.h>
+#include <time.h>
+
+#include "libjobtable/libjobtable.h"
+#include "libscheduler/libscheduler.h"
+#include "libworkload/libworkload.h"
+#include "libeventlog/libeventlog.h"
+#include "libcalltrace/libcalltrace.h"
+#include "liblive/liblive.h"
+#include "libtimerwheel/libtimerwheel.h"
+#include "libtimeseries/libtimeseries.h"
+
+
+/*
+ * The jobs are kept as a struct of arrays rather than an array of structs, so the
+ * passes the main loop makes over every job each time unit (finish detection,
+ * arrival detection and running the time unit) only touch the one or two arrays
+ * they need, in simple loops the compiler can vectorise. What the scheduler needs
+ * to know about a job is in the shared table, which libscheduler works on by row
+ * (see scheduler_set_job_table()); the other columns are the simulator's own, one
+ * entry per row of it. A job keeps its row until it leaves, and a free row has a
+ * run_time, core_id and wake_time of -1, so the passes skip it. New jobs fill the
+ * lowest free rows, so the passes can stop at shared.mcount, after the last row in
+ * use. The rows in use are also listed in order, the order step 1 of the main loop
+ * visits them in: a job taken out of it is replaced by the last one, as the
+ * simulator always has done. position maps each row back to its place in order.
+ */
+typedef struct _simulator_job_table_t
+{
+	jobtable_t shared; //the job number, arrival time, CPU time on arrival, priority and cores of each job
+	int *run_time, *core_id;
+	int *burst_next, *burst_end; //the job's bursts still to come, as a range of the simulator's burst pool
+	int *wake_time; //the time a job blocked on I/O wakes up, -1 if it is not blocked
+	int *order; //the rows in use, shared.mlive of them
+	int *position; //the place of each row in order, -1 for a free row
+	int capacity;
+} simulator_job_table_t;
+
+typedef struct _simulator_arrival_t
+{
+	int job_id, index;
+} simulator_arrival_t;
+
+/*
+ * Everything the main loop carries from one time unit to the next, so a run can be
+ * stopped at the start of any time unit and carried on later (see simulator_run()).
+ */
+typedef struct _simulator_t
+{
+	int cores, scheme, quantum, quiet;
+	int time, job_id, jobs_alive, jobs_blocked;
+	simulator_job_table_t jobs;
+	int *bursts; //the I/O and CPU bursts after each job's first CPU burst, alternating, in time units
+	int burst_ct, burst_cap;
+	long busy_time; //core time units spent running a job
+	int gangs; //1 if some job needs several cores, the jobs are then gang scheduled
+	long fragmented; //core time units left idle while jobs waited
+	int queue_limit, admission, deadline; //admission control, see scheduler_set_admission()
+	int rejected, shed; //jobs turned away on arrival, and dropped from the queue
+	int aging; //the aging interval under PRI and PPRI (see scheduler_set_aging()), -1 if it was not asked for
+	int quantum_latency, quantum_max; //the adaptive quantum under RR, quantum being its minimum (see scheduler_set_quantum_target()), latency 0 if it is fixed
+	int *core_job; //the index in jobs of the job on each core, -1 if the core is idle
+	int *quantum_expiry; //the time the quantum of the job on each core expires, -1 if it has none (RR only)
+	timerwheel_t quantum_timers; //quantum_expiry, indexed by time (rebuilt by simulator_index())
+	int *expired; //the cores whose quantum expires in the current time unit
+	char **core_timing_diagram;
+	int core_timing_diagram_size;
+	int generating;
+	workload_t workload;
+	int arrivals_ct;
+	simulator_arrival_t *arrived;
+	scheduler_arrival_t *arrivals;
+	double *core_speed; //the speed of each core, NULL if every core runs at speed 1
+	int *core_rate; //core_speed in work units per time unit, with a 0 for "no core" first (see job_table_run_rates())
+	long *core_busy; //time units each core spent running a job, also with a slot for "no core" first
+	int work_scale; //work units per time unit of running time: jobs.run_time counts work units
+	eventlog_t *events; //where to log scheduling events, NULL if they are not logged
+	calltrace_t *calls; //where to record the calls made to libscheduler, NULL if they are not recorded
+	timeseries_t *series; //where to write the windowed time series, NULL if it is not written
+} simulator_t;
+
+/*
+ * A saved simulation: a copy of the simulator and a snapshot of the scheduler, both
+ * taken at the start of the same time unit.
+ */
+typedef struct _simulator_checkpoint_t
+{
+	simulator_t sim;
+	scheduler_snapshot_t *scheduler;
+} simulator_checkpoint_t;
+
+#define CHECKPOINT_MAGIC "SIMCKPT8"
+
+void print_usage(char *program_name)
+{
+	fprintf(stderr, "Usage: %s -c <cores> -s <scheme> [options] <input file>\n", program_name);
+	fprintf(stderr, "       %s -c <cores> -s <scheme> [options] -g <workload>\n", program_name);
+	fprintf(stderr, "       %s [-s <scheme>] [options] -R <checkpoint file>\n", program_name);
+	fprintf(stderr, "       %s -c 2 -s fcfs examples/proc1.csv\n", program_name);
+	fprintf(stderr, "\n");
+	fprintf(stderr, "The input file has a header line naming its columns, then one job per line. The columns are\n");
+	fprintf(stderr, "\"Arrival time\", \"Run time\", \"Priority\" and optionally \"Bursts\", the job's bursts as\n");
+	fprintf(stderr, "CPU:IO:CPU:... time units whose CPU bursts add up to the run time, and \"Cores\", the number of\n");
+	fprintf(stderr, "cores the job needs at once (gang scheduled under fcfs, sjf and pri only). Without names the\n");
+	fprintf(stderr, "columns are arrival time, run time, priority and bursts, in that order.\n");
+	fprintf(stderr, "       %s -c 8 -s psjf -q -g seed=7,jobs=1000000,arrival=bursty:16,run=pareto:1.5:2,util=0.95\n", program_name);
+	fprintf(stderr, "\n");
+	fprintf(stderr, "Acceptable schemes are: fcfs, sjf, psjf, pri, ppri, rr#\n");
+	fprintf(stderr, "  -s  also takes a comma separated list of schemes, or all, to compare them side by side\n");
+	fprintf(stderr, "  -q  quiet, only print the final statistics\n");
+	fprintf(stderr, "  -S  print the scheduler's internal counters (requires a build with STATS=1)\n");
+	fprintf(stderr, "  -g  generate a synthetic workload instead of reading a file, where <workload> is a\n");
+	fprintf(stderr, "      comma separated list of: seed=N, jobs=N, util=F, arrival=poisson|bursty:B,\n");
+	fprintf(stderr, "      run=exp:M|bimodal:S:L:P|pareto:A:M, pri=uniform:L:H|weights:W0:W1:...\n");
+	fprintf(stderr, "  -C  write a checkpoint of the simulation to <file> at the start of time unit <time>\n");
+	fprintf(stderr, "  -R  resume the simulation from a checkpoint file, with -s to carry on under another scheme\n");
+	fprintf(stderr, "  -F  run to <time>, then carry on once for each scheme in the comma separated list\n");
+	fprintf(stderr, "      <schemes>, each continuation starting from the same in-memory checkpoint\n");
+	fprintf(stderr, "  -e  log every arrival, dispatch, preemption, quantum expiry and finish to <file>,\n");
+	fprintf(stderr, "      as JSON lines if it ends in .jsonl, otherwise in binary (compare logs with eventdiff)\n");
+	fprintf(stderr, "  -T  record every call made to the scheduler, and its result, to <file> (replay it with replay)\n");
+	fprintf(stderr, "  -t  write a CSV time series to <file>, one row per window of <window> time units: the\n");
+	fprintf(stderr, "      utilisation, average and longest run queue, arrivals, completions and preemptions\n");
+	fprintf(stderr, "  -P  give the cores different speeds: a comma separated list of one speed per core, where\n");
+	fprintf(stderr, "      <n>*<speed> stands for n cores, or @<file> to read the list from a file\n");
+	fprintf(stderr, "  -Q  bound the run queue to <depth> jobs, turning arrivals away by <policy>: reject (the\n");
+	fprintf(stderr, "      arriving job), lowest (the lowest priority job, which may be shed from the queue) or\n");
+	fprintf(stderr, "      deadline:<time> (reject too, and any job expected to wait longer than <time>)\n");
+	fprintf(stderr, "  -A  age waiting jobs under pri and ppri: a job gains a priority level for every <interval>\n");
+	fprintf(stderr, "      time units it has waited in the queue, so none can starve; 0 for no aging. Either way,\n");
+	fprintf(stderr, "      print the average and longest wait of each priority\n");
+	fprintf(stderr, "  -a  adapt the rr quantum to the load, so every runnable job runs within <latency> time\n");
+	fprintf(stderr, "      units: each job's quantum is the latency shared out between the runnable jobs, stretched\n");
+	fprintf(stderr, "      to the average burst when that is a little longer, from the rr quantum up to <max>\n");
+	fprintf(stderr, "      (by default the latency), as in -s rr2 -a 40:10\n");
+	fprintf(stderr, "  -L  after the simulation, run the jobs for real with one pinned thread per core, where a\n");
+	fprintf(stderr, "      time unit is <us> microseconds of work, and compare the measured times with the simulated ones\n");
+}
+
+int job_table_resize(simulator_job_table_t *jobs, int capacity)
+{
+	int **columns[] = { &jobs->run_time, &jobs->core_id, &jobs->burst_next, &jobs->burst_end, &jobs->wake_time, &jobs->order, &jobs->position };
+	unsigned int i;
+
+	for (i = 0; i < sizeof(columns) / sizeof(columns[0]); i++)
+	{
+		int *column = realloc(*columns[i], capacity * sizeof(int));
+		if (column == NULL)
+			return 0;
+		*columns[i] = column;
+	}
+
+	jobs->capacity = capacity;
+	return 1;
+}
+
+int job_table_init(simulator_job_table_t *jobs, int capacity)
+{
+	return jobtable_init(&jobs->shared, capacity) && job_table_resize(jobs, capacity);
+}
+
+/*
+ * Adds a job, whose run_time is its first CPU burst in work units and cpu_time all of
+ * its CPU bursts in time units, returning its row, or -1 if out of memory.
+ */
+int job_table_add(simulator_job_table_t *jobs, int job_id, int arrival_time, int run_time, int cpu_time, int priority, int cores)
+{
+	int i = jobtable_add(&jobs->shared, job_id, arrival_time, cpu_time, priority, cores);
+
+	if (i == -1 || (jobs->shared.mcapacity > jobs->capacity && !job_table_resize(jobs, jobs->shared.mcapacity)))
+		return -1;
+
+	jobs->run_time[i] = run_time;
+	jobs->core_id[i] = -1;
+	jobs->burst_next[i] = 0;
+	jobs->burst_end[i] = 0;
+	jobs->wake_time[i] = -1;
+	jobs->order[jobs->shared.mlive - 1] = i;
+	jobs->position[i] = jobs->shared.mlive - 1;
+
+	return i;
+}
+
+/*
+ * Takes the job at position n of the order out, freeing its row.
+ */
+void job_table_remove(simulator_job_table_t *jobs, int n)
+{
+	int i = jobs->order[n];
+
+	jobtable_remove(&jobs->shared, i);
+	jobs->order[n] = jobs->order[jobs->shared.mlive];
+	jobs->position[jobs->order[n]] = n;
+	jobs->position[i] = -1;
+	jobs->run_time[i] = -1;
+	jobs->core_id[i] = -1;
+	jobs->burst_next[i] = 0;
+	jobs->burst_end[i] = 0;
+	jobs->wake_time[i] = -1;
+}
+
+int job_table_copy(simulator_job_table_t *dst, const simulator_job_table_t *src)
+{
+	int count = src->shared.mcount;
+
+	if (!jobtable_copy(&dst->shared, &src->shared) || (dst->capacity < count && !job_table_resize(dst, count)))
+		return 0;
+
+	memcpy(dst->run_time, src->run_time, count * sizeof(int));
+	memcpy(dst->core_id, src->core_id, count * sizeof(int));
+	memcpy(dst->burst_next, src->burst_next, count * sizeof(int));
+	memcpy(dst->burst_end, src->burst_end, count * sizeof(int));
+	memcpy(dst->wake_time, src->wake_time, count * sizeof(int));
+	memcpy(dst->order, src->order, src->shared.mlive * sizeof(int));
+	memcpy(dst->position, src->position, count * sizeof(int));
+
+	return 1;
+}
+
+void job_table_destroy(simulator_job_table_t *jobs)
+{
+	jobtable_destroy(&jobs->shared);
+	free(jobs->run_time);
+	free(jobs->core_id);
+	free(jobs->burst_next);
+	free(jobs->burst_end);
+	free(jobs->wake_time);
+	free(jobs->order);
+	free(jobs->position);
+}
+
+/*
+ * Number of jobs whose entry in the column is equal to value.
+ */
+int job_table_count(const int * restrict column, int count, int value)
+{
+	int i, matches = 0;
+
+	for (i = 0; i < count; i++)
+		matches += (column[i] == value);
+
+	return matches;
+}
+
+/*
+ * Runs every job that is on a core for one time unit.
+ * @return the number of cores that were working
+ */
+int job_table_run(int * restrict run_time, const int * restrict core_id, int count)
+{
+	int i, cores_working = 0;
+
+	for (i = 0; i < count; i++)
+	{
+		int running = (core_id[i] != -1);
+		run_time[i] -= running;
+		cores_working += running;
+	}
+
+	return cores_working;
+}
+
+/*
+ * Runs the time unit when the cores have different speeds: each running job gets
+ * through its core's rate of work units, never going below zero. rate and busy are
+ * indexed by core_id, and also take core_id -1 (a job that is not running, whose
+ * run_time stays as it is, -1 for a free row).
+ */
+int job_table_run_rates(int * restrict run_time, const int * restrict core_id, const int *rate, long *busy, int count)
+{
+	int i, cores_working = 0;
+
+	for (i = 0; i < count; i++)
+	{
+		int left = run_time[i] - rate[core_id[i]];
+		run_time[i] = (left > 0 || core_id[i] == -1) ? left : 0;
+		busy[core_id[i]]++;
+		cores_working += (core_id[i] != -1);
+	}
+
+	return cores_working;
+}
+
+/*
+ * Puts the job the scheduler has just put on a core on it, returning its row, or -1
+ * if that is not the job the scheduler named.
+ */
+int set_active_job(int job_id, int core_id, simulator_job_table_t *jobs)
+{
+	int i = scheduler_core_row(core_id);
+
+	if (i == -1 || jobs->shared.mjob_id[i] != job_id)
+		return -1;
+
+	jobs->core_id[i] = core_id;
+	return i;
+}
+
+/*
+ * Adds a job's bursts after the first CPU burst to the pool.
+ */
+int simulator_add_bursts(simulator_t *sim, int job, const int *bursts, int count)
+{
+	if (sim->burst_ct + count > sim->burst_cap)
+	{
+		int capacity = sim->burst_cap > 0 ? sim->burst_cap : 64;
+		int *pool;
+
+		while (capacity < sim->burst_ct + count)
+			capacity *= 2;
+		if ((pool = realloc(sim->bursts, capacity * sizeof(int))) == NULL)
+			return 0;
+		sim->bursts = pool;
+		sim->burst_cap = capacity;
+	}
+
+	memcpy(sim->bursts + sim->burst_ct, bursts, count * sizeof(int));
+	sim->jobs.burst_next[job] = sim->burst_ct;
+	sim->jobs.burst_end[job] = sim->burst_ct += count;
+
+	return 1;
+}
+
+/*
+ * The CPU time a job still needs, in time units: its current CPU burst and the ones after it.
+ */
+int job_cpu_time(simulator_t *sim, int i)
+{
+	int cpu_time = sim->jobs.run_time[i] / sim->work_scale;
+	int k;
+
+	for (k = sim->jobs.burst_next[i] + 1; k < sim->jobs.burst_end[i]; k += 2)
+		cpu_time += sim->bursts[k];
+
+	return cpu_time;
+}
+
+int compare_job_ids(const void *a, const void *b)
+{
+	const simulator_arrival_t *arrival_a = (const simulator_arrival_t *)a;
+	const simulator_arrival_t *arrival_b = (const simulator_arrival_t *)b;
+
+	return (arrival_a->job_id > arrival_b->job_id) - (arrival_a->job_id < arrival_b->job_id);
+}
+
+void print_available_jobs(simulator_job_table_t *jobs, int time)
+{
+	printf("Active jobs are: ");
+
+	int i, first = 1;
+	for (i = 0; i < jobs->shared.mcount; i++)
+	{
+		if (jobs->shared.mjob_id[i] != -1 && jobs->shared.marrival_time[i] <= time)
+		{
+			if (first)
+			{
+				printf("%d", jobs->shared.mjob_id[i]);
+				first = 0;
+			}
+			else
+				printf(", %d", jobs->shared.mjob_id[i]);
+		}
+	}
+
+	if (!first)
+		printf("\n");
+}
+
+void print_available_cores(int cores)
+{
+	printf("Active cores are: ");
+
+	int i;
+	for (i = 0; i < cores; i++)
+	{
+		if (i == cores - 1)
+			printf("%d\n", i);
+		else
+			printf("%d, ", i);
+	}
+}
+
+void print_scheduler_stats()
+{
+	scheduler_stats_t stats;
+	int i;
+
+	if (!scheduler_get_stats(&stats))
+	{
+		fprintf(stderr, "Scheduler statistics are not available, rebuild with \"make clean; make STATS=1\".\n");
+		return;
+	}
+
+	printf("\n");
+	printf("Scheduler Statistics:\n");
+	printf("  Comparisons: %ld\n", stats.comparisons);
+	printf("  Queue offers: %ld, polls: %ld\n", stats.offers, stats.polls);
+	printf("  Preemptions: %ld\n", stats.preemptions);
+	printf("  Quantum expiries requeuing the same job: %ld\n", stats.requeues);
+	printf("  Jobs backfilled: %ld\n", stats.backfills);
+	printf("  Queue depth high-water mark: %d\n", stats.max_queue_depth);
+	printf("  Average queue length: %.2f\n", stats.avg_queue_length);
+	for (i = 0; i < stats.cores; i++)
+		printf("  Core %2d: busy %ld, idle %ld\n", i, stats.core_busy[i], stats.core_idle[i]);
+}
+
+
+
+int parse_scheme(const char *name, int *quantum)
+{
+	if (strcasecmp(name, "FCFS") == 0) { return FCFS; }
+	else if (strcasecmp(name, "SJF") == 0) { return SJF; }
+	else if (strcasecmp(name, "PSJF") == 0) { return PSJF; }
+	else if (strcasecmp(name, "PRI") == 0) { return PRI; }
+	else if (strcasecmp(name, "PPRI") == 0) { return PPRI; }
+	else if (strncasecmp(name, "RR", 2) == 0)
+	{
+		*quantum = atoi(name + 2);
+		return RR;
+	}
+
+	return -1;
+}
+
+/*
+ * Parses a comma separated list of schemes into schemes and quanta, which need room
+ * for one entry per comma plus one, and at least 8. "all" stands for every scheme
+ * the examples cover: fcfs, sjf, psjf, pri, ppri, rr1, rr2 and rr4.
+ * @return the number of schemes, 0 if a scheme is unknown, -1 if a RR quantum is not positive
+ */
+int parse_scheme_list(const char *list, int *schemes, int *quanta)
+{
+	char *copy, *name;
+	int count = 0;
+
+	if (strcasecmp(list, "all") == 0)
+		list = "fcfs,sjf,psjf,pri,ppri,rr1,rr2,rr4";
+	copy = strdup(list);
+
+	for (name = strtok(copy, ","); name != NULL; name = strtok(NULL, ","), count++)
+	{
+		quanta[count] = 0;
+		schemes[count] = parse_scheme(name, &quanta[count]);
+
+		if (schemes[count] == -1 || (schemes[count] == RR && quanta[count] <= 0))
+		{
+			count = (schemes[count] == -1) ? 0 : -1;
+			break;
+		}
+	}
+
+	free(copy);
+	return count;
+}
+
+int scheme_list_size(const char *list)
+{
+	int size = 8;
+
+	for (; *list != '\0'; list++)
+		size += (*list == ',');
+
+	return size;
+}
+
+/*
+ * Under RR an adaptive quantum (sim->quantum_latency > 0) runs from quantum up to sim->quantum_max.
+ */
+void print_scheme(const simulator_t *sim, int scheme, int quantum)
+{
+	if (scheme == FCFS) { printf("First Come First Served (FCFS)"); }
+	else if (scheme == SJF) { printf("Non-preemptive Shortest Job First (SJF)"); }
+	else if (scheme == PSJF) { printf("Preemptive Shortest Job First (PSJF)"); }
+	else if (scheme == PRI) { printf("Non-preemptive Priority (PRI)"); }
+	else if (scheme == PPRI) { printf("Preemptive Priority (PPRI)"); }
+	else if (scheme == RR && sim->quantum_latency > 0)
+	{
+		printf("Round Robin (RR) with a quantum of %d to %d adapting to a latency of %d", quantum, sim->quantum_max, sim->quantum_latency);
+	}
+	else if (scheme == RR) { printf("Round Robin (RR) with a quantum of %d", quantum); }
+}
+
+void print_scheme_label(const simulator_t *sim, int scheme, int quantum)
+{
+	const char *names[] = { "FCFS", "SJF", "PSJF", "PRI", "PPRI", "RR" };
+	char label[32];
+
+	if (scheme == RR && sim->quantum_latency > 0)
+	{
+		snprintf(label, sizeof(label), "RR%d-%d", quantum, sim->quantum_max);
+		printf("%-8s", label);
+	}
+	else if (scheme == RR)
+		printf("RR%-6d", quantum);
+	else
+		printf("%-8s", names[scheme]);
+}
+
+
+int simulator_init(simulator_t *sim, int cores, int scheme, int quantum, int quiet)
+{
+	int i;
+
+	memset(sim, 0, sizeof(simulator_t));
+	sim->cores = cores;
+	sim->scheme = scheme;
+	sim->quantum = quantum;
+	sim->quiet = quiet;
+	sim->work_scale = 1;
+	sim->aging = -1;
+
+	sim->core_timing_diagram_size = 1024;
+	sim->arrivals_ct = 16;
+	sim->core_job = malloc(cores * sizeof(int));
+	sim->quantum_expiry = malloc(cores * sizeof(int));
+	sim->expired = malloc(cores * sizeof(int));
+	sim->core_timing_diagram = calloc(cores, sizeof(char *));
+	sim->arrived = malloc(sim->arrivals_ct * sizeof(simulator_arrival_t));
+	sim->arrivals = malloc(sim->arrivals_ct * sizeof(scheduler_arrival_t));
+
+	if (!job_table_init(&sim->jobs, 16) || !sim->core_job || !sim->quantum_expiry || !sim->expired ||
+	    !timerwheel_init(&sim->quantum_timers, cores, -1) || !sim->core_timing_diagram || !sim->arrived || !sim->arrivals)
+		return 0;
+
+	for (i = 0; i < cores; i++)
+	{
+		sim->core_job[i] = -1;
+		sim->quantum_expiry[i] = -1;
+		sim->core_timing_diagram[i] = malloc(sim->core_timing_diagram_size + 1);
+
+		if (sim->core_timing_diagram[i] == NULL)
+			return 0;
+		sim->core_timing_diagram[i][0] = '\0';
+	}
+
+	return 1;
+}
+
+/*
+ * Gives the cores different speeds. A job's running time becomes work, in hundredths
+ * of a time unit, which each core gets through at its own rate.
+ */
+int simulator_set_speeds(simulator_t *sim, const double *speeds)
+{
+	int i;
+
+	sim->core_speed = malloc(sim->cores * sizeof(double));
+	sim->core_rate = malloc((sim->cores + 1) * sizeof(int));
+	sim->core_busy = calloc(sim->cores + 1, sizeof(long));
+	if (!sim->core_speed || !sim->core_rate || !sim->core_busy)
+		return 0;
+
+	sim->work_scale = 100;
+	sim->core_rate[0] = 0;
+	for (i = 0; i < sim->cores; i++)
+	{
+		sim->core_speed[i] = speeds[i];
+		sim->core_rate[i + 1] = (int)(speeds[i] * sim->work_scale + 0.5);
+	}
+
+	return 1;
+}
+
+void simulator_destroy(simulator_t *sim)
+{
+	int i;
+
+	free(sim->arrived);
+	free(sim->arrivals);
+	free(sim->core_speed);
+	free(sim->core_rate);
+	free(sim->core_busy);
+	free(sim->core_job);
+	free(sim->quantum_expiry);
+	free(sim->expired);
+	free(sim->bursts);
+	timerwheel_destroy(&sim->quantum_timers);
+	for (i = 0; sim->core_timing_diagram != NULL && i < sim->cores; i++)
+		free(sim->core_timing_diagram[i]);
+	free(sim->core_timing_diagram);
+	job_table_destroy(&sim->jobs);
+}
+
+/*
+ * Rebuilds what is only there to find things quickly, the core to job map and the
+ * quantum timers, from the job table and quantum_expiry.
+ */
+void simulator_index(simulator_t *sim)
+{
+	int i;
+
+	for (i = 0; i < sim->cores; i++)
+		sim->core_job[i] = -1;
+	for (i = 0; i < sim->jobs.shared.mcount; i++)
+		if (sim->jobs.core_id[i] != -1)
+			sim->core_job[sim->jobs.core_id[i]] = i;
+
+	// The timers expire at the start of a time unit, and the current one has not been expired yet
+	timerwheel_reset(&sim->quantum_timers, sim->time - 1);
+	for (i = 0; i < sim->cores; i++)
+		if (sim->quantum_expiry[i] != -1)
+			timerwheel_set(&sim->quantum_timers, i, sim->quantum_expiry[i]);
+}
+
+int compare_cores(const void *a, const void *b)
+{
+	return (*(const int *)a > *(const int *)b) - (*(const int *)a < *(const int *)b);
+}
+
+/*
+ * Makes dst an independent copy of src.
+ */
+int simulator_copy(simulator_t *dst, simulator_t *src)
+{
+	int i;
+
+	if (!simulator_init(dst, src->cores, src->scheme, src->quantum, src->quiet))
+		return 0;
+
+	dst->time = src->time;
+	dst->job_id = src->job_id;
+	dst->jobs_alive = src->jobs_alive;
+	dst->jobs_blocked = src->jobs_blocked;
+	dst->busy_time = src->busy_time;
+	dst->gangs = src->gangs;
+	dst->fragmented = src->fragmented;
+	dst->queue_limit = src->queue_limit;
+	dst->admission = src->admission;
+	dst->deadline = src->deadline;
+	dst->rejected = src->rejected;
+	dst->shed = src->shed;
+	dst->aging = src->aging;
+	dst->quantum_latency = src->quantum_latency;
+	dst->quantum_max = src->quantum_max;
+	dst->generating = src->generating;
+	dst->workload = src->workload;
+
+	if (src->core_speed != NULL)
+	{
+		if (!simulator_set_speeds(dst, src->core_speed))
+			return 0;
+		memcpy(dst->core_busy, src->core_busy, (src->cores + 1) * sizeof(long));
+	}
+
+	if (!job_table_copy(&dst->jobs, &src->jobs))
+		return 0;
+
+	if (src->burst_ct > 0)
+	{
+		if ((dst->bursts = malloc(src->burst_ct * sizeof(int))) == NULL)
+			return 0;
+		memcpy(dst->bursts, src->bursts, src->burst_ct * sizeof(int));
+		dst->burst_ct = dst->burst_cap = src->burst_ct;
+	}
+
+	memcpy(dst->quantum_expiry, src->quantum_expiry, src->cores * sizeof(int));
+	simulator_index(dst);
+
+	dst->core_timing_diagram_size = src->core_timing_diagram_size;
+	for (i = 0; i < src->cores; i++)
+	{
+		char *diagram = realloc(dst->core_timing_diagram[i], dst->core_timing_diagram_size + 1);
+
+		if (diagram == NULL)
+			return 0;
+		dst->core_timing_diagram[i] = strcpy(diagram, src->core_timing_diagram[i]);
+	}
+
+	return 1;
+}
+
+void log_event(simulator_t *sim, int time, event_type_t type, int core_id, int job_id)
+{
+	if (sim->events != NULL)
+		eventlog_write(sim->events, time, type, core_id, job_id);
+	if (sim->series != NULL)
+		timeseries_event(sim->series, time, type);
+}
+
+void record_call(simulator_t *sim, call_type_t type, int time, int a, int b, int c, int result)
+{
+	if (sim->calls != NULL)
+		calltrace_write(sim->calls, type, time, a, b, c, result);
+}
+
+/*
+ * Starts a new quantum for the job just put on a core, or stops the core's quantum
+ * if it has been left idle.
+ */
+void restart_quantum(simulator_t *sim, int core_id, int time)
+{
+	if (sim->core_job[core_id] != -1)
+	{
+		int quantum = sim->quantum;
+
+		if (sim->quantum_latency > 0)
+		{
+			quantum = scheduler_core_quantum(core_id);
+			record_call(sim, CALL_CORE_QUANTUM, time, core_id, 0, 0, quantum);
+		}
+
+		sim->quantum_expiry[core_id] = time + quantum;
+		timerwheel_set(&sim->quantum_timers, core_id, time + quantum);
+	}
+	else
+	{
+		sim->quantum_expiry[core_id] = -1;
+		timerwheel_cancel(&sim->quantum_timers, core_id);
+	}
+}
+
+/*
+ * Under gang scheduling one call to the scheduler may start several jobs, each on
+ * several cores, so the cores are read back from the scheduler after every call.
+ * A job's core_id is the lowest of its cores.
+ * @return 0 on success, 3 if the scheduler put a job that is not waiting on a core
+ */
+int simulator_sync_gangs(simulator_t *sim, int time)
+{
+	simulator_job_table_t *jobs = &sim->jobs;
+	int i, j;
+
+	for (i = 0; i < sim->cores; i++)
+	{
+		if ((j = scheduler_core_row(i)) == sim->core_job[i])
+			continue;
+
+		sim->core_job[i] = -1;
+		if (j == -1)
+			continue;
+
+		if (j >= jobs->shared.mcount || jobs->shared.mjob_id[j] == -1)
+		{
+			printf("The scheduler put an invalid job on core %d (row == %d).\n", i, j);
+			print_available_jobs(jobs, time);
+			return 3;
+		}
+
+		int job_id = jobs->shared.mjob_id[j];
+
+		// Newly started: its cores are met in increasing order, so the first is the lowest
+		if (jobs->core_id[j] == -1)
+		{
+			jobs->core_id[j] = i;
+			if (!sim->quiet)
+				printf("Job %d is now running on %d core(s) from core %d.\n", job_id, jobs->shared.mcores[j], i);
+		}
+
+		sim->core_job[i] = j;
+		log_event(sim, time, EVENT_DISPATCH, i, job_id);
+	}
+
+	return 0;
+}
+
+/*
+ * Hands the arrivals of this time unit to the scheduler one at a time, in job id
+ * order, when the jobs are gang scheduled.
+ * @return 0 on success, otherwise the exit status of the simulator
+ */
+int simulator_gang_arrivals(simulator_t *sim, int arrived_ct, int time)
+{
+	simulator_job_table_t *jobs = &sim->jobs;
+	simulator_arrival_t *arrived = sim->arrived;
+	int i, j, result;
+
+	for (i = 0, j = 0; j < arrived_ct; i++)
+	{
+		if (jobs->shared.marrival_time[i] == time)
+		{
+			arrived[j].job_id = jobs->shared.mjob_id[i];
+			arrived[j].index = i;
+			j++;
+		}
+	}
+
+	qsort(arrived, arrived_ct, sizeof(simulator_arrival_t), compare_job_ids);
+
+	for (i = 0; i < arrived_ct; i++)
+	{
+		int k = arrived[i].index;
+		int core_id = scheduler_new_gang_row(k, time);
+
+		sim->jobs_alive++;
+		log_event(sim, time, EVENT_ARRIVAL, core_id, jobs->shared.mjob_id[k]);
+
+		if (!sim->quiet)
+			printf("A new job, job %d (running time=%d, priority=%d, cores=%d), arrived.\n",
+					jobs->shared.mjob_id[k], jobs->run_time[k] / sim->work_scale, jobs->shared.mpriority[k], jobs->shared.mcores[k]);
+
+		if ((result = simulator_sync_gangs(sim, time)) != 0)
+			return result;
+	}
+
+	if (!sim->quiet)
+	{
+		printf("  Queue: "); scheduler_show_queue(); printf("\n\n");
+	}
+
+	return 0;
+}
+
+/*
+ * Takes a job that never got to run, turned away by admission control or shed from
+ * the queue, out of the simulation, by its row.
+ * @return 0 on success, 3 if the job is not waiting
+ */
+int simulator_drop_job(simulator_t *sim, int row)
+{
+	simulator_job_table_t *jobs = &sim->jobs;
+
+	if (row < 0 || row >= jobs->shared.mcount || jobs->shared.mjob_id[row] == -1 || jobs->core_id[row] != -1)
+	{
+		printf("The scheduler dropped an invalid job (row == %d).\n", row);
+		print_available_jobs(jobs, sim->time);
+		return 3;
+	}
+
+	job_table_remove(jobs, jobs->position[row]);
+	sim->jobs_alive--;
+
+	return 0;
+}
+
+/*
+ * Drops the arrivals that were rejected, and the jobs shed to make room for others.
+ * @return 0 on success, otherwise the exit status of the simulator
+ */
+int simulator_drop_rejected(simulator_t *sim, scheduler_arrival_t *arrivals, int arrived_ct, int time)
+{
+	const int *shed;
+	int i, shed_ct, result;
+
+	for (i = 0; i < arrived_ct; i++)
+	{
+		if (arrivals[i].core != SCHEDULER_REJECTED)
+			continue;
+		if ((result = simulator_drop_job(sim, arrivals[i].row)) != 0)
+			return result;
+		sim->rejected++;
+	}
+
+	shed_ct = scheduler_shed_jobs(&shed);
+	for (i = 0; i < shed_ct; i++)
+	{
+		int job_id = shed[i] >= 0 && shed[i] < sim->jobs.shared.mcount ? sim->jobs.shared.mjob_id[shed[i]] : -1;
+
+		log_event(sim, time, EVENT_SHED, -1, job_id);
+		if (!sim->quiet)
+			printf("Job %d was shed from the queue.\n", job_id);
+		if ((result = simulator_drop_job(sim, shed[i])) != 0)
+			return result;
+		sim->shed++;
+	}
+
+	return 0;
+}
+
+int simulator_done(simulator_t *sim)
+{
+	return sim->jobs.shared.mlive == 0 && (!sim->generating || workload_peek(&sim->workload) < 0);
+}
+
+/*
+ * Runs the simulation until every job has finished, or until the start of time unit
+ * until (when until >= 0), where it can be carried on by calling this again.
+ * @return 0 on success, otherwise the exit status of the simulator
+ */
+int simulator_run(simulator_t *sim, int until)
+{
+	simulator_job_table_t *jobs = &sim->jobs;
+	int cores = sim->cores, scheme = sim->scheme, quantum = sim->quantum, quiet = sim->quiet;
+	int *core_job = sim->core_job;
+	char **core_timing_diagram = sim->core_timing_diagram;
+	int i, j, n;
+
+	while (!simulator_done(sim) && (until < 0 || sim->time < until))
+	{
+		int time = sim->time;
+
+		if (!quiet)
+			printf("=== [TIME %d] ===\n", time);
+
+		/*
+		 * 1. Check if any jobs finished in the last time unit, or finished a CPU burst and now wait for I/O.
+		 *
+		 * Counting them first is a branch-free pass over run_time; most time units nobody finishes.
+		 */
+		int finished = job_table_count(jobs->run_time, jobs->shared.mcount, 0);
+
+		for (n = 0; finished > 0 && n < jobs->shared.mlive; n++)
+		{
+			i = jobs->order[n];
+
+			if (jobs->run_time[i] == 0 && jobs->burst_next[i] < jobs->burst_end[i])
+			{
+				// Notify the scheduler the job has blocked, and line up its next CPU burst
+				int job_id = jobs->shared.mjob_id[i];
+				int core_id = jobs->core_id[i];
+				int io_time = sim->bursts[jobs->burst_next[i]];
+				int new_job_id = scheduler_job_blocked(core_id, job_id, time);
+
+				record_call(sim, CALL_JOB_BLOCKED, time, core_id, job_id, 0, new_job_id);
+
+				log_event(sim, time, EVENT_BLOCK, core_id, job_id);
+				if (new_job_id != -1)
+					log_event(sim, time, EVENT_DISPATCH, core_id, new_job_id);
+
+				jobs->run_time[i] = sim->bursts[jobs->burst_next[i] + 1] * sim->work_scale;
+				jobs->burst_next[i] += 2;
+				jobs->wake_time[i] = time + io_time;
+				jobs->core_id[i] = -1;
+				core_job[core_id] = -1;
+				sim->jobs_blocked++;
+				finished--;
+
+				// Set the new job
+				if ( new_job_id != -1 && (core_job[core_id] = set_active_job(new_job_id, core_id, jobs)) == -1 )
+				{
+					printf("The scheduler_job_blocked() selected an invalid job (job_id == %d).\n", new_job_id);
+					print_available_jobs(jobs, time);
+					return 3;
+				}
+
+				if (scheme == RR)
+					restart_quantum(sim, core_id, time);
+
+				if (!quiet)
+				{
+					printf("Job %d, running on core %d, blocked on I/O until time %d. Core %d is now running job %d.\n", job_id, core_id, time + io_time, core_id, new_job_id);
+					printf("  Queue: "); scheduler_show_queue(); printf("\n\n");
+				}
+			}
+			else if (jobs->run_time[i] == 0 && sim->gangs)
+			{
+				// Notify the scheduler, which frees every core of the job and starts whatever now fits
+				int job_id = jobs->shared.mjob_id[i];
+				int core_id = jobs->core_id[i];
+				int result;
+
+				scheduler_job_finished(core_id, job_id, time);
+				log_event(sim, time, EVENT_FINISH, core_id, job_id);
+
+				if (!quiet)
+					printf("Job %d, running on %d core(s) from core %d, finished.\n", job_id, jobs->shared.mcores[i], core_id);
+
+				// Delete the finished job, freeing its row
+				for (j = 0; j < cores; j++)
+					if (core_job[j] == i)
+						core_job[j] = -1;
+				job_table_remove(jobs, n);
+				sim->jobs_alive--;
+				finished--;
+				n--;
+
+				if ((result = simulator_sync_gangs(sim, time)) != 0)
+					return result;
+
+				if (!quiet)
+				{
+					printf("  Queue: "); scheduler_show_queue(); printf("\n\n");
+				}
+			}
+			else if (jobs->run_time[i] == 0)
+			{
+				// Notify the scheduler has finished
+				int job_id = jobs->shared.mjob_id[i];
+				int core_id = jobs->core_id[i];
+				int new_job_id = scheduler_job_finished(core_id, job_id, time);
+
+				record_call(sim, CALL_JOB_FINISHED, time, core_id, job_id, 0, new_job_id);
+
+				log_event(sim, time, EVENT_FINISH, core_id, job_id);
+				if (new_job_id != -1)
+					log_event(sim, time, EVENT_DISPATCH, core_id, new_job_id);
+
+				// Delete the finished jobs, decrease the number of active jobs
+				job_table_remove(jobs, n);
+				core_job[core_id] = -1;
+				sim->jobs_alive--;
+				finished--;
+				n--;
+
+				// Set the new job
+				if ( new_job_id != -1 && (core_job[core_id] = set_active_job(new_job_id, core_id, jobs)) == -1 )
+				{
+					printf("The scheduler_job_finished() selected an invalid job (job_id == %d).\n", new_job_id);
+					print_available_jobs(jobs, time);
+					return 3;
+				}
+
+				if (scheme == RR)
+					restart_quantum(sim, core_id, time);
+
+				if (!quiet)
+				{
+					printf("Job %d, running on core %d, finished. Core %d is now running job %d.\n", job_id, core_id, core_id, new_job_id);
+					printf("  Queue: "); scheduler_show_queue(); printf("\n\n");
+				}
+			}
+		}
+
+		/*
+		 * Check to see if we finished our last job.  (If we don't check here, we would run an extra time unit that will be totally idle.)
+		 */
+		if (simulator_done(sim))
+			break;
+
+		/*
+		 * 2. Check of any quantums expired in the last time unit.
+		 *
+		 * The timer wheel hands back just the cores whose quantum expires now, which are
+		 * then dealt with in core order.
+		 */
+		if (scheme == RR)
+		{
+			int expired_ct = timerwheel_expire(&sim->quantum_timers, time, sim->expired);
+
+			if (expired_ct > 1)
+				qsort(sim->expired, expired_ct, sizeof(int), compare_cores);
+
+			for (i = 0; i < expired_ct; i++)
+			{
+				int core_id = sim->expired[i];
+				j = core_job[core_id];
+
+				sim->quantum_expiry[core_id] = -1;
+				if (j == -1)
+					continue;
+
+				// Notify the scheduler the quantum has expired
+				int old_job_id = jobs->shared.mjob_id[j];
+				int new_job_id = scheduler_quantum_expired(core_id, time);
+
+				record_call(sim, CALL_QUANTUM_EXPIRED, time, core_id, 0, 0, new_job_id);
+
+				log_event(sim, time, EVENT_EXPIRE, core_id, old_job_id);
+				if (new_job_id != -1)
+					log_event(sim, time, EVENT_DISPATCH, core_id, new_job_id);
+
+				jobs->core_id[j] = -1;
+				core_job[core_id] = -1;
+
+				// Set the new job
+				if ( new_job_id != -1 && (core_job[core_id] = set_active_job(new_job_id, core_id, jobs)) == -1 )
+				{
+					printf("The scheduler_quantum_expired() selected an invalid job (job_id == %d).\n", new_job_id);
+					print_available_jobs(jobs, time);
+					return 3;
+				}
+
+				restart_quantum(sim, core_id, time);
+
+				if (!quiet)
+				{
+					printf("Job %d, running on core %d, had its quantum expire. Core %d is now running job %d.\n", old_job_id, core_id, core_id, new_job_id);
+					printf("  Queue: "); scheduler_show_queue(); printf("\n\n");
+				}
+			}
+		}
+
+
+		/*
+		 * 3. Wake up the jobs whose I/O is done, in job id order.
+		 */
+		int woken_ct = sim->jobs_blocked > 0 ? job_table_count(jobs->wake_time, jobs->shared.mcount, time) : 0;
+
+		if (woken_ct > sim->arrivals_ct)
+		{
+			while (sim->arrivals_ct < woken_ct)
+				sim->arrivals_ct *= 2;
+			sim->arrived = realloc(sim->arrived, sim->arrivals_ct * sizeof(simulator_arrival_t));
+			sim->arrivals = realloc(sim->arrivals, sim->arrivals_ct * sizeof(scheduler_arrival_t));
+
+			if (!sim->arrived || !sim->arrivals)
+			{
+				fprintf(stderr, "Out of memory.\n");
+				return 2;
+			}
+		}
+
+		if (woken_ct > 0)
+		{
+			simulator_arrival_t *woken = sim->arrived;
+
+			for (i = 0, j = 0; j < woken_ct; i++)
+			{
+				if (jobs->wake_time[i] == time)
+				{
+					woken[j].job_id = jobs->shared.mjob_id[i];
+					woken[j].index = i;
+					j++;
+				}
+			}
+
+			qsort(woken, woken_ct, sizeof(simulator_arrival_t), compare_job_ids);
+
+			for (i = 0; i < woken_ct; i++)
+			{
+				int k = woken[i].index;
+				int new_job_core_id = scheduler_job_woke_row(k, time);
+
+				record_call(sim, CALL_JOB_WOKE, time, jobs->shared.mjob_id[k], 0, 0, new_job_core_id);
+
+				jobs->wake_time[k] = -1;
+				sim->jobs_blocked--;
+
+				if (new_job_core_id < -1 || new_job_core_id >= cores)
+				{
+					printf("The scheduler_job_woke() selected an invalid core (core_id == %d).\n", new_job_core_id);
+					print_available_cores(cores);
+					return 3;
+				}
+
+				log_event(sim, time, EVENT_WAKE, new_job_core_id, jobs->shared.mjob_id[k]);
+
+				if (new_job_core_id >= 0)
+				{
+					// Take the core from whoever is using it
+					if ((j = core_job[new_job_core_id]) != -1)
+					{
+						jobs->core_id[j] = -1;
+						log_event(sim, time, EVENT_PREEMPT, new_job_core_id, jobs->shared.mjob_id[j]);
+					}
+
+					jobs->core_id[k] = new_job_core_id;
+					core_job[new_job_core_id] = k;
+					log_event(sim, time, EVENT_DISPATCH, new_job_core_id, jobs->shared.mjob_id[k]);
+
+					if (scheme == RR)
+						restart_quantum(sim, new_job_core_id, time);
+				}
+
+				if (quiet)
+					continue;
+
+				if (new_job_core_id >= 0)
+					printf("Job %d (running time left=%d) finished its I/O. Job %d is now running on core %d.\n",
+							jobs->shared.mjob_id[k], job_cpu_time(sim, k), jobs->shared.mjob_id[k], new_job_core_id);
+				else
+					printf("Job %d (running time left=%d) finished its I/O. Job %d is set to idle (-1).\n",
+							jobs->shared.mjob_id[k], job_cpu_time(sim, k), jobs->shared.mjob_id[k]);
+				printf("  Queue: "); scheduler_show_queue(); printf("\n\n");
+			}
+		}
+
+
+		/*
+		 * 4. Check for any new jobs that arrive in this time unit
+		 */
+		while (sim->generating && workload_peek(&sim->workload) == time)
+		{
+			int arrival_time, run_time, priority;
+
+			workload_next(&sim->workload, &arrival_time, &run_time, &priority);
+			if (job_table_add(jobs, sim->job_id++, arrival_time, run_time * sim->work_scale, run_time, priority, 1) == -1)
+			{
+				fprintf(stderr, "Out of memory.\n");
+				return 2;
+			}
+		}
+
+		// As in step 1, count first so the common case is a single vectorised pass
+		int arrived_ct = job_table_count(jobs->shared.marrival_time, jobs->shared.mcount, time);
+
+		if (arrived_ct > sim->arrivals_ct)
+		{
+			while (sim->arrivals_ct < arrived_ct)
+				sim->arrivals_ct *= 2;
+			sim->arrived = realloc(sim->arrived, sim->arrivals_ct * sizeof(simulator_arrival_t));
+			sim->arrivals = realloc(sim->arrivals, sim->arrivals_ct * sizeof(scheduler_arrival_t));
+
+			if (!sim->arrived || !sim->arrivals)
+			{
+				fprintf(stderr, "Out of memory.\n");
+				return 2;
+			}
+		}
+
+		if (arrived_ct > 0 && sim->gangs)
+		{
+			int result = simulator_gang_arrivals(sim, arrived_ct, time);
+
+			if (result != 0)
+				return result;
+		}
+		else if (arrived_ct > 0)
+		{
+			simulator_arrival_t *arrived = sim->arrived;
+			scheduler_arrival_t *arrivals = sim->arrivals;
+
+			for (i = 0, j = 0; j < arrived_ct; i++)
+			{
+				if (jobs->shared.marrival_time[i] == time)
+				{
+					arrived[j].job_id = jobs->shared.mjob_id[i];
+					arrived[j].index = i;
+					j++;
+				}
+			}
+
+			// Hand every arrival of this time unit to the scheduler at once, in job id order
+			qsort(arrived, arrived_ct, sizeof(simulator_arrival_t), compare_job_ids);
+
+			for (i = 0; i < arrived_ct; i++)
+			{
+				int k = arrived[i].index;
+				arrivals[i].job_number = jobs->shared.mjob_id[k];
+				arrivals[i].running_time = job_cpu_time(sim, k);
+				arrivals[i].priority = jobs->shared.mpriority[k];
+				arrivals[i].row = k;
+				sim->jobs_alive++;
+			}
+
+			scheduler_new_jobs(arrivals, arrived_ct, time);
+
+			record_call(sim, CALL_NEW_JOBS, time, arrived_ct, 0, 0, 0);
+			for (i = 0; sim->calls != NULL && i < arrived_ct; i++)
+				record_call(sim, CALL_ARRIVAL, time, arrivals[i].job_number, arrivals[i].running_time, arrivals[i].priority, arrivals[i].core);
+
+			for (i = 0; i < arrived_ct; i++)
+			{
+				int k = arrived[i].index;
+				int new_job_core_id = arrivals[i].core;
+
+				if ((new_job_core_id < -1 && (new_job_core_id != SCHEDULER_REJECTED || sim->admission == ADMIT_ALL)) || new_job_core_id >= cores)
+				{
+					printf("The scheduler_new_jobs() selected an invalid core (core_id == %d).\n", new_job_core_id);
+					print_available_cores(cores);
+					return 3;
+				}
+
+				log_event(sim, time, new_job_core_id == SCHEDULER_REJECTED ? EVENT_REJECT : EVENT_ARRIVAL,
+						new_job_core_id == SCHEDULER_REJECTED ? -1 : new_job_core_id, jobs->shared.mjob_id[k]);
+
+				if (quiet)
+					continue;
+
+				if (new_job_core_id >= 0)
+					printf("A new job, job %d (running time=%d, priority=%d), arrived. Job %d is now running on core %d.\n",
+							jobs->shared.mjob_id[k], arrivals[i].running_time, jobs->shared.mpriority[k], jobs->shared.mjob_id[k], new_job_core_id);
+				else if (new_job_core_id == SCHEDULER_REJECTED)
+					printf("A new job, job %d (running time=%d, priority=%d), arrived. Job %d was rejected, the queue is full.\n",
+							jobs->shared.mjob_id[k], arrivals[i].running_time, jobs->shared.mpriority[k], jobs->shared.mjob_id[k]);
+				else
+					printf("A new job, job %d (running time=%d, priority=%d), arrived. Job %d is set to idle (-1).\n",
+							jobs->shared.mjob_id[k], arrivals[i].running_time, jobs->shared.mpriority[k], jobs->shared.mjob_id[k]);
+			}
+
+			if (!quiet)
+			{
+				printf("  Queue: "); scheduler_show_queue(); printf("\n\n");
+			}
+
+			for (i = 0; i < arrived_ct; i++)
+			{
+				int new_job_core_id = arrivals[i].core;
+
+				if (new_job_core_id < 0)
+					continue;
+
+				// Take the core from whoever is using it
+				if ((j = core_job[new_job_core_id]) != -1)
+				{
+					jobs->core_id[j] = -1;
+					log_event(sim, time, EVENT_PREEMPT, new_job_core_id, jobs->shared.mjob_id[j]);
+				}
+
+				// Assign the core to the new job
+				jobs->core_id[arrived[i].index] = new_job_core_id;
+				core_job[new_job_core_id] = arrived[i].index;
+				log_event(sim, time, EVENT_DISPATCH, new_job_core_id, arrivals[i].job_number);
+
+				if (scheme == RR)
+					restart_quantum(sim, new_job_core_id, time);
+			}
+
+			if (sim->admission != ADMIT_ALL)
+			{
+				int result = simulator_drop_rejected(sim, arrivals, arrived_ct, time);
+
+				if (result != 0)
+					return result;
+			}
+		}
+
+
+		/*
+		 * 5. Run the time unit.
+		 */
+		int cores_working;
+
+		if (sim->core_rate != NULL)
+			cores_working = job_table_run_rates(jobs->run_time, jobs->core_id, sim->core_rate + 1, sim->core_busy + 1, jobs->shared.mcount);
+		else
+			cores_working = job_table_run(jobs->run_time, jobs->core_id, jobs->shared.mcount);
+		// cores_working counts jobs, a gang keeps several cores busy
+		int cores_busy = sim->gangs ? cores - job_table_count(core_job, cores, -1) : cores_working;
+
+		sim->busy_time += cores_busy;
+		if (sim->jobs_alive - sim->jobs_blocked > cores_working)
+			sim->fragmented += cores - cores_busy;
+		if (sim->series != NULL)
+			timeseries_tick(sim->series, time, cores_busy, sim->jobs_alive - sim->jobs_blocked - cores_working);
+
+		// Each core's entry is added to its diagram as soon as it is written, so one
+		// buffer does for every core, and a quiet run does not touch the cores at all
+		for (i = 0; i < cores && !quiet; i++)
+		{
+			char time_string[14];
+			int job_id = (core_job[i] != -1) ? jobs->shared.mjob_id[core_job[i]] : -1;
+
+			// If the core is idle, print a '-'
+			if (job_id == -1)
+				strcpy(time_string, "-");
+			else if (job_id < 10)
+				sprintf(time_string, "%d", job_id);
+			else if (job_id < 10 + 26)
+				sprintf(time_string, "%c", job_id - 10 + 'a');
+			else if (job_id < 10 + 26 + 26)
+				sprintf(time_string, "%c", job_id - 10 - 26 + 'A');
+			else
+				snprintf(time_string, sizeof(time_string), "(%d)", job_id);
+
+			// Ensure we have enough memory
+			while (strlen(core_timing_diagram[i]) + strlen(time_string) >= (unsigned int)sim->core_timing_diagram_size)
+			{
+				sim->core_timing_diagram_size *= 2;
+
+				for (j = 0; j < cores; j++)
+				{
+					core_timing_diagram[j] = realloc(core_timing_diagram[j], sim->core_timing_diagram_size + 1);
+
+					if (core_timing_diagram[j] == NULL)
+					{
+						fprintf(stderr, "Out of memory.\n");
+						return 3;
+					}
+				}
+			}
+
+			strcat( core_timing_diagram[i], time_string );
+		}
+
+
+		/*
+		 * 6. Print data!
+		 */
+		if (!quiet)
+		{
+			printf("At the end of time unit %d...\n", time);
+
+			for (i = 0; i < cores; i++)
+				printf("  Core %2d: %s\n", i, core_timing_diagram[i]);
+
+			printf("\n");
+
+			printf("  Queue: ");
+			scheduler_show_queue();
+			printf("\n");
+			printf("\n");
+		}
+
+
+		/*
+		 * 7. Sanity Checking
+		 *
+		 * - If there's a job alive (needing to be ran) and all CPUs are idle, the scheduler failed to schedule properly.
+		 *   Jobs blocked on I/O do not count, they cannot be run.
+		 */
+		if (sim->jobs_alive > sim->jobs_blocked && cores_working == 0)
+		{
+			printf("All cores are idle and at least one job remains unscheduled.\n");
+			print_available_jobs(jobs, time);
+			return 3;
+		}
+
+
+		/*
+		 * 8. Increase time
+		 */
+		sim->time++;
+	}
+
+	return 0;
+}
+
+/*
+ * Waiting time of the finished jobs of each priority, highest priority first.
+ */
+void print_wait_classes()
+{
+	scheduler_wait_class_t classes[64];
+	int i, count = scheduler_wait_classes(classes, sizeof(classes) / sizeof(classes[0]));
+
+	printf("\nWaiting time per priority:\n");
+	printf("  Priority        Jobs   Avg Waiting   Max Waiting\n");
+	for (i = 0; i < count; i++)
+		printf("  %8d  %10d  %12.2f  %12d\n", classes[i].priority, classes[i].jobs, classes[i].total_wait / classes[i].jobs, classes[i].max_wait);
+}
+
+/*
+ * Utilisation of each class of cores, the cores sharing a speed, fastest first.
+ */
+void print_core_classes(simulator_t *sim)
+{
+	int i, j;
+	char *done = calloc(sim->cores, 1);
+
+	printf("\nCore class utilisation:\n");
+	while (1)
+	{
+		int first = -1, count = 0;
+		long busy = 0;
+
+		for (i = 0; i < sim->cores; i++)
+			if (!done[i] && (first == -1 || sim->core_speed[i] > sim->core_speed[first]))
+				first = i;
+		if (first == -1)
+			break;
+
+		for (j = 0; j < sim->cores; j++)
+		{
+			if (!done[j] && sim->core_speed[j] == sim->core_speed[first])
+			{
+				done[j] = 1;
+				count++;
+				busy += sim->core_busy[j + 1];
+			}
+		}
+
+		printf("  Speed %5.2f x %3d core(s): %6.2f%% busy\n", sim->core_speed[first], count,
+				sim->time > 0 ? 100.0 * busy / ((double)count * sim->time) : 0.0);
+	}
+
+	free(done);
+}
+
+void simulator_report(simulator_t *sim, double elapsed, int show_stats)
+{
+	int i;
+
+	if (!sim->quiet)
+	{
+		printf("FINAL TIMING DIAGRAM:\n");
+		for (i = 0; i < sim->cores; i++)
+			printf("  Core %2d: %s\n", i, sim->core_timing_diagram[i]);
+	}
+	else
+		printf("Simulated %d job(s) over %d time unit(s) in %.3f second(s).\n", sim->job_id, sim->time, elapsed);
+
+	printf("\n");
+	printf("Average Waiting Time: %.2f\n", scheduler_average_waiting_time());
+	printf("Average Turnaround Time: %.2f\n", scheduler_average_turnaround_time());
+	printf("Average Response Time: %.2f\n", scheduler_average_response_time());
+
+	if (sim->burst_ct > 0 || sim->gangs)
+		printf("CPU Utilisation: %.2f%%\n", sim->time > 0 ? 100.0 * sim->busy_time / ((double)sim->cores * sim->time) : 0.0);
+	if (sim->gangs)
+		printf("Fragmentation: %.2f%% of core time idle while jobs waited\n", sim->time > 0 ? 100.0 * sim->fragmented / ((double)sim->cores * sim->time) : 0.0);
+	if (sim->admission != ADMIT_ALL)
+	{
+		printf("Rejected Jobs: %d, Shed Jobs: %d\n", sim->rejected, sim->shed);
+		printf("Goodput: %.3f completed job(s) per time unit\n", sim->time > 0 ? (double)(sim->job_id - sim->rejected - sim->shed) / sim->time : 0.0);
+	}
+
+	if (sim->aging >= 0)
+		print_wait_classes();
+
+	if (sim->core_speed != NULL)
+		print_core_classes(sim);
+
+	if (show_stats)
+		print_scheduler_stats();
+}
+
+
+/*
+ * Saves the simulation at the start of its current time unit. The simulation itself
+ * is not changed and can carry on.
+ */
+int simulator_save(simulator_t *sim, simulator_checkpoint_t *checkpoint)
+{
+	memset(checkpoint, 0, sizeof(simulator_checkpoint_t));
+
+	checkpoint->scheduler = scheduler_snapshot(sim->time);
+	return checkpoint->scheduler != NULL && simulator_copy(&checkpoint->sim, sim);
+}
+
+/*
+ * Sets up sim, and the scheduler, to carry on from a checkpoint under the given
+ * scheme. The checkpoint is left untouched, so it can be resumed any number of times.
+ */
+int simulator_resume(simulator_checkpoint_t *checkpoint, simulator_t *sim, int scheme, int quantum, int quiet)
+{
+	int i;
+
+	if (!simulator_copy(sim, &checkpoint->sim))
+		return 0;
+
+	scheduler_restore(checkpoint->scheduler, scheme, &sim->jobs.shared);
+	if (sim->core_speed != NULL)
+		scheduler_set_core_speeds(sim->core_speed);
+	if (sim->admission != ADMIT_ALL)
+		scheduler_set_admission(sim->queue_limit, sim->admission, sim->deadline);
+	// The adaptive quantum starts from the quantum of the scheme resumed under
+	if (sim->quantum_latency > 0)
+		scheduler_set_quantum_target(scheme == RR ? sim->quantum_latency : 0, quantum, sim->quantum_max);
+
+	// Jobs already on a core start a fresh quantum, or keep what is left of theirs if that is shorter
+	for (i = 0; i < sim->cores; i++)
+	{
+		int fresh = (sim->quantum_latency > 0 && scheme == RR && sim->core_job[i] != -1) ? scheduler_core_quantum(i) : quantum;
+
+		if (scheme != RR || sim->core_job[i] == -1)
+			sim->quantum_expiry[i] = -1;
+		else if (sim->scheme != RR || sim->quantum_expiry[i] == -1 || sim->quantum_expiry[i] > sim->time + fresh)
+			sim->quantum_expiry[i] = sim->time + fresh;
+	}
+
+	sim->scheme = scheme;
+	sim->quantum = quantum;
+	sim->quiet = quiet;
+	simulator_index(sim);
+
+	// The job table only has the lowest core of a gang, the scheduler knows them all
+	for (i = 0; sim->gangs && i < sim->cores; i++)
+		sim->core_job[i] = scheduler_core_row(i);
+	return 1;
+}
+
+void simulator_checkpoint_free(simulator_checkpoint_t *checkpoint)
+{
+	simulator_destroy(&checkpoint->sim);
+	scheduler_snapshot_free(checkpoint->scheduler);
+}
+
+/*
+ * Checkpoint files hold the simulator's state in the machine's own binary layout,
+ * followed by the scheduler's snapshot. They are only meant to be read back by the
+ * same build of the simulator.
+ */
+int simulator_checkpoint_write(simulator_checkpoint_t *checkpoint, const char *file_name)
+{
+	simulator_t *sim = &checkpoint->sim;
+	int header[] = { sim->cores, sim->scheme, sim->quantum, sim->time, sim->job_id, sim->jobs_alive,
+	                 sim->generating, sim->jobs.shared.mcount, sim->core_timing_diagram_size, sim->jobs_blocked, sim->burst_ct, sim->gangs,
+	                 sim->queue_limit, sim->admission, sim->deadline, sim->rejected, sim->shed, sim->aging,
+	                 sim->quantum_latency, sim->quantum_max };
+	int *columns[] = { sim->jobs.run_time, sim->jobs.core_id, sim->jobs.burst_next, sim->jobs.burst_end, sim->jobs.wake_time };
+	size_t count = sim->jobs.shared.mcount, cores = sim->cores, bursts = sim->burst_ct;
+	unsigned int i;
+
+	// Quanta are saved as the time units left, -1 for none
+	int *quantum_left = malloc(cores * sizeof(int));
+	if (quantum_left == NULL)
+		return 0;
+	for (i = 0; i < cores; i++)
+		quantum_left[i] = (sim->quantum_expiry[i] != -1) ? sim->quantum_expiry[i] - sim->time : -1;
+
+	FILE *file = fopen(file_name, "wb");
+	if (file == NULL)
+	{
+		free(quantum_left);
+		return 0;
+	}
+
+	int ok = fwrite(CHECKPOINT_MAGIC, 8, 1, file) == 1 &&
+	         fwrite(header, sizeof(header), 1, file) == 1 &&
+	         fwrite(&sim->workload, sizeof(workload_t), 1, file) == 1 &&
+	         fwrite(&sim->busy_time, sizeof(long), 1, file) == 1 &&
+	         fwrite(&sim->fragmented, sizeof(long), 1, file) == 1 &&
+	         fwrite(quantum_left, sizeof(int), cores, file) == cores &&
+	         (bursts == 0 || fwrite(sim->bursts, sizeof(int), bursts, file) == bursts) &&
+	         jobtable_write(&sim->jobs.shared, file);
+	free(quantum_left);
+
+	for (i = 0; ok && i < sizeof(columns) / sizeof(columns[0]); i++)
+		ok = fwrite(columns[i], sizeof(int), count, file) == count;
+	ok = ok && fwrite(sim->jobs.order, sizeof(int), sim->jobs.shared.mlive, file) == (size_t)sim->jobs.shared.mlive;
+
+	for (i = 0; ok && i < cores; i++)
+	{
+		int length = strlen(sim->core_timing_diagram[i]);
+		ok = fwrite(&length, sizeof(int), 1, file) == 1 &&
+		     fwrite(sim->core_timing_diagram[i], 1, length, file) == (size_t)length;
+	}
+
+	ok = ok && scheduler_snapshot_write(checkpoint->scheduler, file);
+
+	return (fclose(file) == 0) && ok;
+}
+
+int simulator_checkpoint_read(simulator_checkpoint_t *checkpoint, const char *file_name)
+{
+	simulator_t *sim = &checkpoint->sim;
+	char magic[8];
+	int header[20];
+	unsigned int i;
+
+	memset(checkpoint, 0, sizeof(simulator_checkpoint_t));
+
+	FILE *file = fopen(file_name, "rb");
+	if (file == NULL)
+		return 0;
+
+	int ok = fread(magic, 8, 1, file) == 1 && memcmp(magic, CHECKPOINT_MAGIC, 8) == 0 &&
+	         fread(header, sizeof(header), 1, file) == 1 &&
+	         header[0] > 0 && header[7] >= 0 && header[8] > 0 && header[9] >= 0 && header[10] >= 0 &&
+	         simulator_init(sim, header[0], header[1], header[2], 0) &&
+	         job_table_resize(&sim->jobs, header[7] > 16 ? header[7] : 16);
+
+	if (ok)
+	{
+		int *columns[] = { sim->jobs.run_time, sim->jobs.core_id, sim->jobs.burst_next, sim->jobs.burst_end, sim->jobs.wake_time };
+		size_t count = header[7], cores = header[0], bursts = header[10];
+
+		sim->time = header[3];
+		sim->job_id = header[4];
+		sim->jobs_alive = header[5];
+		sim->generating = header[6];
+		sim->core_timing_diagram_size = header[8];
+		sim->jobs_blocked = header[9];
+		sim->burst_ct = sim->burst_cap = header[10];
+		sim->gangs = header[11];
+		sim->queue_limit = header[12];
+		sim->admission = header[13];
+		sim->deadline = header[14];
+		sim->rejected = header[15];
+		sim->shed = header[16];
+		sim->aging = header[17];
+		sim->quantum_latency = header[18];
+		sim->quantum_max = header[19];
+
+		ok = fread(&sim->workload, sizeof(workload_t), 1, file) == 1 &&
+		     fread(&sim->busy_time, sizeof(long), 1, file) == 1 &&
+		     fread(&sim->fragmented, sizeof(long), 1, file) == 1 &&
+		     fread(sim->quantum_expiry, sizeof(int), cores, file) == cores &&
+		     (bursts == 0 || ((sim->bursts = malloc(bursts * sizeof(int))) != NULL &&
+		                      fread(sim->bursts, sizeof(int), bursts, file) == bursts));
+
+		// The shared table comes whole, its free rows included
+		jobtable_destroy(&sim->jobs.shared);
+		ok = ok && jobtable_read(&sim->jobs.shared, file) && sim->jobs.shared.mcount == header[7];
+
+		for (i = 0; ok && i < sizeof(columns) / sizeof(columns[0]); i++)
+			ok = fread(columns[i], sizeof(int), count, file) == count;
+		ok = ok && fread(sim->jobs.order, sizeof(int), sim->jobs.shared.mlive, file) == (size_t)sim->jobs.shared.mlive;
+		for (i = 0; ok && i < count; i++)
+			sim->jobs.position[i] = -1;
+		for (i = 0; ok && i < (size_t)sim->jobs.shared.mlive; i++)
+		{
+			ok = sim->jobs.order[i] >= 0 && sim->jobs.order[i] < sim->jobs.shared.mcount && sim->jobs.shared.mjob_id[sim->jobs.order[i]] != -1 &&
+			     sim->jobs.position[sim->jobs.order[i]] == -1;
+			if (ok)
+				sim->jobs.position[sim->jobs.order[i]] = i;
+		}
+
+		for (i = 0; ok && i < cores; i++)
+			if (sim->quantum_expiry[i] != -1)
+				sim->quantum_expiry[i] += sim->time;
+		if (ok)
+			simulator_index(sim);
+
+		for (i = 0; ok && i < cores; i++)
+		{
+			int length;
+			char *diagram = realloc(sim->core_timing_diagram[i], sim->core_timing_diagram_size + 1);
+
+			ok = diagram != NULL;
+			if (ok)
+				sim->core_timing_diagram[i] = diagram;
+
+			ok = ok && fread(&length, sizeof(int), 1, file) == 1 &&
+			     length >= 0 && length <= sim->core_timing_diagram_size &&
+			     fread(diagram, 1, length, file) == (size_t)length;
+			if (ok)
+				diagram[length] = '\0';
+		}
+	}
+
+	ok = ok && (checkpoint->scheduler = scheduler_snapshot_read(file)) != NULL;
+
+	fclose(file);
+	return ok;
+}
+
+/*
+ * Parses "<time>:<rest>" option arguments, returning rest or NULL.
+ */
+char *parse_time_prefix(char *arg, int *time)
+{
+	char *end;
+	long value = strtol(arg, &end, 10);
+
+	if (end == arg || *end != ':' || end[1] == '\0' || value < 0)
+		return NULL;
+
+	*time = value;
+	return end + 1;
+}
+
+/*
+ * The columns of an input file, see find_fields()
+ */
+enum { FIELD_ARRIVAL = 0, FIELD_RUN, FIELD_PRIORITY, FIELD_BURSTS, FIELD_CORES, FIELDS };
+
+/*
+ * Splits a line of the input file at its commas, in place, dropping the quotes and
+ * white space around each field. Empty fields are kept.
+ * @return the number of fields
+ */
+int split_fields(char *line, char **fields, int max)
+{
+	int count = 0;
+
+	while (count < max)
+	{
+		char *comma = strchr(line, ',');
+		char *end = (comma != NULL) ? comma : line + strlen(line);
+
+		while (*line == ' ' || *line == '"')
+			line++;
+		while (end > line && strchr(" \"\r\n", end[-1]) != NULL)
+			end--;
+		*end = '\0';
+		fields[count++] = line;
+
+		if (comma == NULL)
+			break;
+		line = comma + 1;
+	}
+
+	return count;
+}
+
+/*
+ * Finds each column by its name in the header line, case insensitively. A header
+ * that names none of them stands for arrival time, run time, priority and bursts,
+ * in that order.
+ */
+void find_fields(char *header, int *columns)
+{
+	static const char *names[FIELDS] = { "arrival time", "run time", "priority", "bursts", "cores" };
+	char *fields[64];
+	int count = split_fields(header, fields, 64);
+	int i, f, named = 0;
+
+	for (f = 0; f < FIELDS; f++)
+	{
+		columns[f] = -1;
+		for (i = 0; i < count; i++)
+			if (strcasecmp(fields[i], names[f]) == 0)
+				columns[f] = i;
+		named += (columns[f] != -1);
+	}
+
+	for (f = 0; !named && f < FIELDS; f++)
+		columns[f] = (f <= FIELD_BURSTS) ? f : -1;
+}
+
+/*
+ * Parses a job's bursts, CPU:IO:CPU:...:CPU in time units, every one positive, that
+ * start and end with a CPU burst and whose CPU bursts add up to run_time.
+ * @return the number of bursts, 0 if they are malformed
+ */
+int parse_bursts(const char *list, int run_time, int *bursts, int max)
+{
+	int count = 0, cpu_time = 0;
+	char *end;
+
+	while (*list == ' ' || *list == '"')
+		list++;
+
+	while (1)
+	{
+		long burst = strtol(list, &end, 10);
+
+		if (end == list || burst <= 0 || count == max)
+			return 0;
+		bursts[count] = burst;
+		if (count % 2 == 0)
+			cpu_time += burst;
+		count++;
+
+		if (*end != ':')
+			break;
+		list = end + 1;
+	}
+
+	while (*end == ' ' || *end == '"')
+		end++;
+
+	return (*end == '\0' && count % 2 == 1 && cpu_time == run_time) ? count : 0;
+}
+
+/*
+ * Parses a list of core speeds: comma or white space separated speeds, each either
+ * <speed> or <cores>*<speed>, with # starting a comment. "@<file>" reads the list
+ * from a file. There must be exactly one speed per core.
+ * @return 1 on success, 0 otherwise
+ */
+int parse_core_speeds(const char *spec, int cores, double *speeds)
+{
+	char *list, *token, *save;
+	int count = 0;
+
+	if (spec[0] == '@')
+	{
+		FILE *file = fopen(spec + 1, "r");
+		long size;
+
+		if (file == NULL || fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < 0 || fseek(file, 0, SEEK_SET) != 0)
+		{
+			if (file != NULL)
+				fclose(file);
+			return 0;
+		}
+
+		list = calloc(size + 1, 1);
+		if (list == NULL || fread(list, 1, size, file) != (size_t)size)
+		{
+			free(list);
+			fclose(file);
+			return 0;
+		}
+		fclose(file);
+
+		// Blank out the comments
+		for (token = strchr(list, '#'); token != NULL; token = strchr(token, '#'))
+			while (*token != '\0' && *token != '\n')
+				*token++ = ' ';
+	}
+	else
+		list = strdup(spec);
+
+	for (token = strtok_r(list, ", \t\r\n", &save); token != NULL; token = strtok_r(NULL, ", \t\r\n", &save))
+	{
+		char *end;
+		long repeat = 1;
+		double speed;
+
+		if (strchr(token, '*') != NULL)
+		{
+			repeat = strtol(token, &end, 10);
+			if (end == token || *end != '*' || repeat <= 0)
+				break;
+			token = end + 1;
+		}
+
+		speed = strtod(token, &end);
+		if (end == token || *end != '\0' || speed < 0.01 || count + repeat > cores)
+			break;
+
+		while (repeat-- > 0)
+			speeds[count++] = speed;
+	}
+
+	free(list);
+	return token == NULL && count == cores;
+}
+
+/*
+ * Parses -Q <depth>:reject|lowest|deadline:<time>.
+ * @return 1 on success, 0 if the spec is malformed
+ */
+int parse_admission(const char *spec, int *queue_limit, int *admission, int *deadline)
+{
+	char *end;
+
+	*queue_limit = strtol(spec, &end, 10);
+	if (end == spec || *end != ':' || *queue_limit < 0)
+		return 0;
+	spec = end + 1;
+
+	if (strcasecmp(spec, "reject") == 0)
+		*admission = ADMIT_REJECT_NEWEST;
+	else if (strcasecmp(spec, "lowest") == 0)
+		*admission = ADMIT_DROP_LOWEST;
+	else if (strncasecmp(spec, "deadline:", 9) == 0)
+	{
+		*admission = ADMIT_DEADLINE;
+		*deadline = strtol(spec + 9, &end, 10);
+		return end != spec + 9 && *end == '\0' && *deadline >= 0;
+	}
+	else
+		return 0;
+
+	return 1;
+}
+
+/*
+ * Parses -a <latency>[:<max>], where the maximum quantum defaults to the latency.
+ * @return 1 on success, 0 if the spec is malformed
+ */
+int parse_quantum_target(const char *spec, int *latency, int *max_quantum)
+{
+	char *end;
+
+	*latency = strtol(spec, &end, 10);
+	if (end == spec || *latency <= 0)
+		return 0;
+	*max_quantum = *latency;
+	if (*end == '\0')
+		return 1;
+	if (*end != ':')
+		return 0;
+
+	spec = end + 1;
+	*max_quantum = strtol(spec, &end, 10);
+	return end != spec && *end == '\0' && *max_quantum > 0;
+}
+
+/*
+ * Whether a scheme can gang schedule jobs that need several cores: only the
+ * non-preemptive ones can.
+ */
+int gang_scheme(int scheme)
+{
+	return scheme == FCFS || scheme == SJF || scheme == PRI;
+}
+
+double elapsed_since(struct timespec *start)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+
+int main(int argc, char **argv)
+{
+	int c;
+	int cores = 0, scheme = -1, quantum = 0, quiet = 0, show_stats = 0;
+	char *file_name = NULL, *workload_spec = NULL;
+	char *checkpoint_file = NULL, *resume_file = NULL, *fork_list = NULL, *event_file = NULL, *trace_file = NULL;
+	char *series_file = NULL;
+	int checkpoint_time = -1, fork_time = -1, series_window = 0;
+	int fork_ct = 0, *fork_scheme = NULL, *fork_quantum = NULL;
+	int scheme_ct = 0, *schemes = NULL, *quanta = NULL;
+	long live_unit = 0;
+	char *speed_spec = NULL;
+	int queue_limit = 0, admission = ADMIT_ALL, deadline = 0;
+	int aging = -1;
+	int quantum_latency = 0, quantum_max = 0;
+	double *speeds = NULL;
+
+	/*
+	 * Parse command line options.
+	 */
+	while ((c = getopt(argc, argv, "c:s:qSg:C:R:F:e:T:t:L:P:Q:A:a:")) != -1)
+	{
+		switch (c)
+		{
+			case 'c':
+				cores = atoi(optarg);
+
+				if (cores <= 0)
+				{
+					fprintf(stderr, "Option -c <cores> require a positive number.\n");
+					print_usage(argv[0]);
+					return 1;
+				}
+				break;
+
+			case 's':
+				free(schemes);
+				free(quanta);
+				schemes = malloc(scheme_list_size(optarg) * sizeof(int));
+				quanta = malloc(scheme_list_size(optarg) * sizeof(int));
+				scheme_ct = parse_scheme_list(optarg, schemes, quanta);
+
+				if (scheme_ct == -1)
+				{
+					fprintf(stderr, "Option -s <scheme> requires a positive number for the quantum of RR. (Eg: -s RR2)\n");
+					print_usage(argv[0]);
+					return 1;
+				}
+
+				scheme = (scheme_ct > 0) ? schemes[0] : -1;
+				quantum = (scheme_ct > 0) ? quanta[0] : 0;
+				break;
+
+			case 'q':
+				quiet = 1;
+				break;
+
+			case 'S':
+				show_stats = 1;
+				break;
+
+			case 'g':
+				workload_spec = optarg;
+				break;
+
+			case 'C':
+				if ((checkpoint_file = parse_time_prefix(optarg, &checkpoint_time)) == NULL)
+				{
+					fprintf(stderr, "Option -C requires <time>:<file>. (Eg: -C 40:run.ckpt)\n");
+					print_usage(argv[0]);
+					return 1;
+				}
+				break;
+
+			case 'e':
+				event_file = optarg;
+				break;
+
+			case 'T':
+				trace_file = optarg;
+				break;
+
+			case 't':
+				if ((series_file = parse_time_prefix(optarg, &series_window)) == NULL || series_window <= 0)
+				{
+					fprintf(stderr, "Option -t requires <window>:<file>, with a window of at least 1. (Eg: -t 1000:load.csv)\n");
+					print_usage(argv[0]);
+					return 1;
+				}
+				break;
+
+			case 'R':
+				resume_file = optarg;
+				break;
+
+			case 'P':
+				speed_spec = optarg;
+				break;
+
+			case 'Q':
+				if (!parse_admission(optarg, &queue_limit, &admission, &deadline))
+				{
+					fprintf(stderr, "Option -Q requires <depth>:reject, <depth>:lowest or <depth>:deadline:<time>. (Eg: -Q 100:lowest)\n");
+					print_usage(argv[0]);
+					return 1;
+				}
+				break;
+
+			case 'A':
+				aging = atoi(optarg);
+
+				if (aging < 0 || (aging == 0 && strcmp(optarg, "0") != 0))
+				{
+					fprintf(stderr, "Option -A requires an aging interval of 0 or more. (Eg: -A 50)\n");
+					print_usage(argv[0]);
+					return 1;
+				}
+				break;
+
+			case 'a':
+				if (!parse_quantum_target(optarg, &quantum_latency, &quantum_max))
+				{
+					fprintf(stderr, "Option -a requires a positive latency, optionally followed by a positive maximum quantum. (Eg: -a 40 or -a 40:8)\n");
+					print_usage(argv[0]);
+					return 1;
+				}
+				break;
+
+			case 'L':
+				live_unit = atol(optarg);
+
+				if (live_unit <= 0)
+				{
+					fprintf(stderr, "Option -L <us> requires a positive number of microseconds per time unit.\n");
+					print_usage(argv[0]);
+					return 1;
+				}
+				break;
+
+			case 'F':
+				if ((fork_list = parse_time_prefix(optarg, &fork_time)) == NULL)
+				{
+					fprintf(stderr, "Option -F requires <time>:<schemes>. (Eg: -F 40:psjf,ppri,rr4)\n");
+					print_usage(argv[0]);
+					return 1;
+				}
+				break;
+
+			case '?':
+				print_usage(argv[0]);
+				return 1;
+
+			default:
+				printf("...\n");
+				break;
+		}
+	}
+
+	if (cores == 0 && resume_file == NULL)
+	{
+		fprintf(stderr, "Required option -c <cores> is not present.\n");
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	if (scheme == -1 && resume_file == NULL)
+	{
+		fprintf(stderr, "Required option -s <scheme> is not present.\n");
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	if (resume_file != NULL && workload_spec == NULL && optind == argc)
+		file_name = NULL;
+	else if (resume_file == NULL && workload_spec != NULL && optind == argc)
+		file_name = NULL;
+	else if (resume_file == NULL && workload_spec == NULL && optind == argc - 1)
+		file_name = argv[optind];
+	else
+	{
+		fprintf(stderr, "A single input file, a workload (-g) or a checkpoint (-R), and only one of them, is required.\n");
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	if (fork_list != NULL)
+	{
+		fork_scheme = malloc(scheme_list_size(fork_list) * sizeof(int));
+		fork_quantum = malloc(scheme_list_size(fork_list) * sizeof(int));
+
+		if ((fork_ct = parse_scheme_list(fork_list, fork_scheme, fork_quantum)) <= 0)
+		{
+			fprintf(stderr, "Option -F requires a list of valid schemes. (Eg: -F 40:psjf,ppri,rr4)\n");
+			print_usage(argv[0]);
+			return 1;
+		}
+
+		if (checkpoint_file != NULL && checkpoint_time > fork_time)
+		{
+			fprintf(stderr, "Option -C <time> must not be later than -F <time>.\n");
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+
+
+	if (scheme_ct > 1 && (checkpoint_file != NULL || fork_list != NULL || show_stats || event_file != NULL || series_file != NULL))
+	{
+		fprintf(stderr, "Options -C, -F, -S, -e and -t take a single scheme.\n");
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	if (fork_list != NULL && (event_file != NULL || series_file != NULL))
+	{
+		fprintf(stderr, "Options -e and -t cannot be combined with -F.\n");
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	// A trace has to start with scheduler_start_up() to be replayed
+	if (trace_file != NULL && (scheme_ct > 1 || fork_list != NULL || resume_file != NULL))
+	{
+		fprintf(stderr, "Option -T cannot be combined with several schemes, -F or -R.\n");
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	if (speed_spec != NULL)
+	{
+		if (checkpoint_file != NULL || resume_file != NULL || trace_file != NULL || live_unit > 0)
+		{
+			fprintf(stderr, "Option -P cannot be combined with -C, -R, -T or -L.\n");
+			print_usage(argv[0]);
+			return 1;
+		}
+
+		speeds = malloc(cores * sizeof(double));
+		if (!parse_core_speeds(speed_spec, cores, speeds))
+		{
+			fprintf(stderr, "Option -P requires one positive speed per core. (Eg: -c 8 -P 4*2,4*1 or -P @speeds.txt)\n");
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+
+	// The RR quantum is the least an adaptive one can be
+	if (quantum_latency > 0)
+	{
+		int k;
+
+		for (k = 0; k < scheme_ct + fork_ct; k++)
+		{
+			int rr_quantum = (k < scheme_ct) ? quanta[k] : fork_quantum[k - scheme_ct];
+
+			if (rr_quantum > quantum_max)
+			{
+				fprintf(stderr, "Option -a needs a maximum quantum no shorter than the quantum of RR, %d.\n", rr_quantum);
+				print_usage(argv[0]);
+				return 1;
+			}
+		}
+	}
+
+	if (live_unit > 0 && (scheme_ct > 1 || checkpoint_file != NULL || fork_list != NULL || resume_file != NULL || admission != ADMIT_ALL ||
+	                      quantum_latency > 0))
+	{
+		fprintf(stderr, "Option -L cannot be combined with several schemes, -C, -F, -R, -Q or -a.\n");
+		print_usage(argv[0]);
+		return 1;
+	}
+
+
+	simulator_t sim;
+
+	if (resume_file != NULL)
+	{
+		/*
+		 * Carry on from a checkpoint, under its own scheme unless -s says otherwise.
+		 */
+		simulator_checkpoint_t checkpoint;
+
+		if (!simulator_checkpoint_read(&checkpoint, resume_file))
+		{
+			fprintf(stderr, "Unable to read checkpoint file \"%s\".\n", resume_file);
+			return 2;
+		}
+
+		if (cores != 0 && cores != checkpoint.sim.cores)
+		{
+			fprintf(stderr, "The checkpoint was taken with %d core(s), it cannot be resumed on %d.\n", checkpoint.sim.cores, cores);
+			return 1;
+		}
+
+		cores = checkpoint.sim.cores;
+		if (scheme == -1)
+		{
+			scheme = checkpoint.sim.scheme;
+			quantum = checkpoint.sim.quantum;
+		}
+
+		if (!simulator_resume(&checkpoint, &sim, scheme, quantum, quiet))
+		{
+			fprintf(stderr, "Out of memory.\n");
+			return 2;
+		}
+		simulator_checkpoint_free(&checkpoint);
+
+		printf("Resumed %d core(s) and %d job(s) at time %d using ", cores, sim.job_id, sim.time);
+	}
+	else
+	{
+		if (!simulator_init(&sim, cores, scheme, quantum, quiet) || (speeds != NULL && !simulator_set_speeds(&sim, speeds)))
+		{
+			fprintf(stderr, "Out of memory.\n");
+			return 2;
+		}
+
+		/*
+		 * Generated workloads are streamed into the jobs data structure as they arrive (see step 4).
+		 */
+		if (workload_spec != NULL && workload_init(&sim.workload, workload_spec, cores) != 0)
+		{
+			print_usage(argv[0]);
+			return 1;
+		}
+		sim.generating = (workload_spec != NULL);
+
+		/*
+		 * Open the file, read the file, and populate the jobs data structure.
+		 */
+		FILE *file = NULL;
+		if (file_name != NULL && (file = fopen(file_name, "r")) == NULL)
+		{
+			fprintf(stderr, "Unable to open file \"%s\".\n", file_name);
+			return 2;
+		}
+
+		char line[1024 + 1];
+		char *fields[64];
+		int columns[FIELDS], bursts[512];
+		if (file != NULL && fgets(line, 1024, file) != NULL)
+			find_fields(line, columns);
+		while (file != NULL && fgets(line, 1024, file) != NULL)
+		{
+			int field_ct = split_fields(line, fields, 64);
+			char *field[FIELDS];
+			int f, burst_ct = 0, job_cores = 1;
+
+			for (f = 0; f < FIELDS; f++)
+				field[f] = (columns[f] != -1 && columns[f] < field_ct) ? fields[columns[f]] : "";
+
+			if (*field[FIELD_ARRIVAL] == '\0' || *field[FIELD_RUN] == '\0' || *field[FIELD_PRIORITY] == '\0')
+			{
+				fprintf(stderr, "Illegal file format.\n");
+				return 2;
+			}
+
+			if (*field[FIELD_BURSTS] != '\0' &&
+			    (burst_ct = parse_bursts(field[FIELD_BURSTS], atoi(field[FIELD_RUN]), bursts, sizeof(bursts) / sizeof(bursts[0]))) == 0)
+			{
+				fprintf(stderr, "Illegal bursts for job %d, expected CPU:IO:...:CPU adding up to the run time.\n", sim.job_id);
+				return 2;
+			}
+
+			if (*field[FIELD_CORES] != '\0' && ((job_cores = atoi(field[FIELD_CORES])) < 1 || job_cores > cores))
+			{
+				fprintf(stderr, "Job %d needs %s core(s), it has to be between 1 and %d.\n", sim.job_id, field[FIELD_CORES], cores);
+				return 2;
+			}
+
+			// The first CPU burst is the run time the job starts with, the rest wait in the burst pool
+			int first = burst_ct > 0 ? bursts[0] : atoi(field[FIELD_RUN]);
+			int k = job_table_add(&sim.jobs, sim.job_id, atoi(field[FIELD_ARRIVAL]), first * sim.work_scale, atoi(field[FIELD_RUN]), atoi(field[FIELD_PRIORITY]), job_cores);
+
+			if (k == -1 || (burst_ct > 1 && !simulator_add_bursts(&sim, k, bursts + 1, burst_ct - 1)))
+			{
+				fprintf(stderr, "Out of memory.\n");
+				return 2;
+			}
+
+			sim.gangs |= (job_cores > 1);
+			sim.job_id++;
+		}
+
+		if (file != NULL)
+			fclose(file);
+
+
+		/*
+		 * Run the simulation.
+		 */
+
+		if (file_name != NULL)
+			printf("Loaded %d core(s) and %d job(s) using ", cores, sim.job_id);
+		else
+		{
+			printf("Generating %ld job(s) (", workload_size(&sim.workload));
+			workload_print(&sim.workload, stdout);
+			printf(") on %d core(s) using ", cores);
+		}
+
+		scheduler_start_up(cores, scheme);
+		scheduler_set_job_table(&sim.jobs.shared);
+		if (speeds != NULL)
+			scheduler_set_core_speeds(speeds);
+	}
+
+	// A resumed simulation keeps the checkpoint's admission control unless -Q says otherwise
+	if (admission != ADMIT_ALL)
+	{
+		sim.queue_limit = queue_limit;
+		sim.admission = admission;
+		sim.deadline = deadline;
+		scheduler_set_admission(queue_limit, admission, deadline);
+	}
+
+	// Likewise for aging
+	if (aging >= 0)
+	{
+		sim.aging = aging;
+		scheduler_set_aging(aging);
+	}
+
+	// And for the adaptive quantum, which starts from the RR quantum
+	if (quantum_latency > 0)
+	{
+		sim.quantum_latency = quantum_latency;
+		sim.quantum_max = quantum_max;
+		scheduler_set_quantum_target(scheme == RR ? quantum_latency : 0, quantum, quantum_max);
+	}
+
+	if (scheme_ct > 1)
+		printf("%d schemes...\n\n", scheme_ct);
+	else
+	{
+		print_scheme(&sim, scheme, quantum);
+		printf(" scheduling...\n\n");
+	}
+
+
+	int i, result;
+	struct timespec wall_start;
+	live_job_t *live_jobs = NULL;
+	int live_ct = 0;
+
+	if (live_unit > 0 && sim.burst_ct > 0)
+	{
+		fprintf(stderr, "Option -L cannot be used with jobs that do I/O.\n");
+		return 1;
+	}
+
+	if (sim.gangs)
+	{
+		int gang_schemes = gang_scheme(scheme);
+
+		for (i = 0; i < scheme_ct; i++)
+			gang_schemes &= gang_scheme(schemes[i]);
+		for (i = 0; i < fork_ct; i++)
+			gang_schemes &= gang_scheme(fork_scheme[i]);
+
+		if (!gang_schemes || sim.burst_ct > 0 || speeds != NULL || trace_file != NULL || live_unit > 0 || sim.admission != ADMIT_ALL)
+		{
+			fprintf(stderr, "Jobs that need several cores are only scheduled under fcfs, sjf and pri, cannot do I/O,\n");
+			fprintf(stderr, "and cannot be combined with -P, -T, -L or -Q.\n");
+			return 1;
+		}
+	}
+
+	/*
+	 * Take a copy of every job before the simulation uses them up, for the live run.
+	 * Generated jobs are produced again by a copy of the generator.
+	 */
+	if (live_unit > 0)
+	{
+		workload_t workload = sim.workload;
+
+		live_ct = sim.jobs.shared.mcount + (sim.generating ? workload_size(&workload) : 0);
+		live_jobs = malloc((live_ct > 0 ? live_ct : 1) * sizeof(live_job_t));
+		if (live_jobs == NULL)
+		{
+			fprintf(stderr, "Out of memory.\n");
+			return 2;
+		}
+
+		for (i = 0; i < sim.jobs.shared.mcount; i++)
+		{
+			live_jobs[i].job_id = sim.jobs.shared.mjob_id[i];
+			live_jobs[i].arrival_time = sim.jobs.shared.marrival_time[i];
+			live_jobs[i].run_time = sim.jobs.run_time[i] / sim.work_scale;
+			live_jobs[i].priority = sim.jobs.shared.mpriority[i];
+		}
+		for (; sim.generating && i < live_ct; i++)
+		{
+			live_jobs[i].job_id = i;
+			workload_next(&workload, &live_jobs[i].arrival_time, &live_jobs[i].run_time, &live_jobs[i].priority);
+		}
+	}
+	eventlog_t events;
+	calltrace_t calls;
+	timeseries_t series;
+
+	if (event_file != NULL)
+	{
+		if (!eventlog_open(&events, event_file, 1))
+		{
+			fprintf(stderr, "Unable to open event log \"%s\".\n", event_file);
+			return 2;
+		}
+		sim.events = &events;
+	}
+
+	if (trace_file != NULL)
+	{
+		if (!calltrace_open(&calls, trace_file))
+		{
+			fprintf(stderr, "Unable to open call trace \"%s\".\n", trace_file);
+			return 2;
+		}
+		sim.calls = &calls;
+		record_call(&sim, CALL_START_UP, 0, cores, scheme, 0, 0);
+		if (sim.admission != ADMIT_ALL)
+			record_call(&sim, CALL_SET_ADMISSION, 0, sim.queue_limit, sim.admission, sim.deadline, 0);
+		if (sim.aging > 0)
+			record_call(&sim, CALL_SET_AGING, 0, sim.aging, 0, 0, 0);
+		if (sim.quantum_latency > 0 && scheme == RR)
+			record_call(&sim, CALL_SET_QUANTUM, 0, sim.quantum_latency, quantum, sim.quantum_max, 0);
+	}
+
+	if (series_file != NULL)
+	{
+		if (!timeseries_open(&series, series_file, series_window, sim.cores, sim.time))
+		{
+			fprintf(stderr, "Unable to open time series \"%s\".\n", series_file);
+			return 2;
+		}
+		sim.series = &series;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &wall_start);
+
+	/*
+	 * Several schemes: each one carries on from the same in-memory checkpoint of the
+	 * loaded jobs, so the input is only read (or generated) once, and the results are
+	 * tabulated side by side. The scheduler library is a single instance, so the
+	 * schemes run one after the other.
+	 */
+	if (scheme_ct > 1)
+	{
+		simulator_checkpoint_t checkpoint;
+
+		if (!simulator_save(&sim, &checkpoint))
+		{
+			fprintf(stderr, "Out of memory.\n");
+			return 2;
+		}
+		simulator_destroy(&sim);
+
+		printf("Scheme   Avg Waiting  Avg Turnaround  Avg Response  Time Units  Seconds\n");
+
+		for (i = 0; i < scheme_ct; i++)
+		{
+			clock_gettime(CLOCK_MONOTONIC, &wall_start);
+
+			if (!simulator_resume(&checkpoint, &sim, schemes[i], quanta[i], 1))
+			{
+				fprintf(stderr, "Out of memory.\n");
+				return 2;
+			}
+
+			if ((result = simulator_run(&sim, -1)) != 0)
+				return result;
+
+			print_scheme_label(&sim, schemes[i], quanta[i]);
+			printf(" %11.2f  %14.2f  %12.2f  %10d  %7.3f\n", scheduler_average_waiting_time(), scheduler_average_turnaround_time(),
+					scheduler_average_response_time(), sim.time, elapsed_since(&wall_start));
+			simulator_destroy(&sim);
+		}
+
+		simulator_checkpoint_free(&checkpoint);
+		scheduler_clean_up();
+		free(schemes);
+		free(quanta);
+		free(speeds);
+
+		return 0;
+	}
+
+	/*
+	 * Checkpoint to a file, then carry on as if nothing happened.
+	 */
+	if (checkpoint_file != NULL)
+	{
+		simulator_checkpoint_t checkpoint;
+
+		if ((result = simulator_run(&sim, checkpoint_time)) != 0)
+			return result;
+
+		if (simulator_done(&sim))
+			fprintf(stderr, "The simulation finished before time %d, no checkpoint was written.\n", checkpoint_time);
+		else if (!simulator_save(&sim, &checkpoint) || !simulator_checkpoint_write(&checkpoint, checkpoint_file))
+		{
+			fprintf(stderr, "Unable to write checkpoint file \"%s\".\n", checkpoint_file);
+			return 2;
+		}
+		else
+		{
+			fprintf(stderr, "Checkpoint of time %d written to \"%s\".\n", checkpoint_time, checkpoint_file);
+			simulator_checkpoint_free(&checkpoint);
+		}
+	}
+
+	/*
+	 * Fork: run up to the fork time once, then carry on from an in-memory checkpoint
+	 * for each scheme, so every continuation only pays for its own tail.
+	 */
+	if (fork_list != NULL)
+	{
+		simulator_checkpoint_t checkpoint;
+
+		if ((result = simulator_run(&sim, fork_time)) != 0)
+			return result;
+
+		if (simulator_done(&sim))
+			fprintf(stderr, "The simulation finished before time %d, there is nothing to fork.\n", fork_time);
+		else
+		{
+			if (!simulator_save(&sim, &checkpoint))
+			{
+				fprintf(stderr, "Out of memory.\n");
+				return 2;
+			}
+			simulator_destroy(&sim);
+
+			printf("Forking %d continuation(s) at time %d, after %.3f second(s).\n", fork_ct, fork_time, elapsed_since(&wall_start));
+
+			for (i = 0; i < fork_ct; i++)
+			{
+				printf("\n=== What-if from time %d: ", fork_time);
+				print_scheme(&sim, fork_scheme[i], fork_quantum[i]);
+				printf(" ===\n\n");
+
+				clock_gettime(CLOCK_MONOTONIC, &wall_start);
+
+				if (!simulator_resume(&checkpoint, &sim, fork_scheme[i], fork_quantum[i], quiet))
+				{
+					fprintf(stderr, "Out of memory.\n");
+					return 2;
+				}
+
+				if ((result = simulator_run(&sim, -1)) != 0)
+					return result;
+
+				simulator_report(&sim, elapsed_since(&wall_start), show_stats);
+				simulator_destroy(&sim);
+			}
+
+			simulator_checkpoint_free(&checkpoint);
+			scheduler_clean_up();
+			free(fork_scheme);
+			free(fork_quantum);
+			free(schemes);
+			free(quanta);
+			free(speeds);
+
+			return 0;
+		}
+	}
+
+	if ((result = simulator_run(&sim, -1)) != 0)
+		return result;
+
+	if (event_file != NULL && !eventlog_close(&events))
+	{
+		fprintf(stderr, "Unable to write event log \"%s\".\n", event_file);
+		return 2;
+	}
+
+	if (trace_file != NULL && !calltrace_close(&calls))
+	{
+		fprintf(stderr, "Unable to write call trace \"%s\".\n", trace_file);
+		return 2;
+	}
+
+	if (series_file != NULL && !timeseries_close(&series, sim.time))
+	{
+		fprintf(stderr, "Unable to write time series \"%s\".\n", series_file);
+		return 2;
+	}
+
+	simulator_report(&sim, elapsed_since(&wall_start), show_stats);
+
+	double predicted[3] = { scheduler_average_waiting_time(), scheduler_average_turnaround_time(), scheduler_average_response_time() };
+	scheduler_clean_up();
+
+	if (live_unit > 0)
+	{
+		live_result_t live;
+
+		result = live_run(live_jobs, live_ct, cores, scheme, quantum, live_unit * 1000LL, &live);
+		if (result == 0)
+		{
+			fprintf(stderr, "Unable to start the core threads.\n");
+			return 2;
+		}
+		else if (result == -1)
+		{
+			printf("\nThe live run stopped: the scheduler chose an invalid job or left jobs waiting with every core idle.\n");
+			return 3;
+		}
+
+		printf("\n");
+		printf("Live run (1 time unit = %ld us): %d core thread(s), %d pinned over %d CPU(s), %.3f second(s), %ld preempted slice(s) lost.\n",
+				live_unit, cores, live.pinned, live.cpus, live.seconds, live.lost);
+		printf("                 Simulated       Live\n");
+		printf("Avg Waiting     %10.2f %10.2f\n", predicted[0], live.waiting);
+		printf("Avg Turnaround  %10.2f %10.2f\n", predicted[1], live.turnaround);
+		printf("Avg Response    %10.2f %10.2f\n", predicted[2], live.response);
+		free(live_jobs);
+	}
+
+	free(fork_scheme);
+	free(fork_quantum);
+	free(schemes);
+	free(quanta);
+	free(speeds);
+	simulator_destroy(&sim);
+
+	return 0;
+}